@@ -1,4 +1,5 @@
 #include "framework/maths.h"
+#include "framework/containers/buffer.h"
 #include "framework/input.h"
 #include "framework/formatter.h"
 
@@ -9,6 +10,7 @@
 #include "framework/platform/gpu_context.h"
 #include "framework/systems/memory.h"
 #include "framework/systems/defer.h"
+#include "framework/systems/assets.h"
 
 #include "framework/graphics/misc.h"
 
@@ -28,8 +30,14 @@ static struct Application {
 		uint64_t elapsed;
 		uint64_t fixed_accumulator;
 	} ticks;
+
+	uint64_t frame;
+	struct File * memory_telemetry;
+	struct Buffer memory_telemetry_buffer;
 } gs_app;
 
+#define APPLICATION_MEMORY_TELEMETRY_PATH "memory_telemetry.csv"
+
 static uint64_t get_target_ticks(void) {
 	int32_t  const vsync_mode   = gpu_context_get_vsync(gs_app.gpu_context);
 	uint64_t const vsync_factor = (vsync_mode > 0) ? (uint64_t)vsync_mode : 1;
@@ -52,13 +60,26 @@ static void application_init(void) {
 		"  vsync ........ %d\n"
 		"  target rate .. %u\n"
 		"  fixed rate ... %u\n"
+		"  telemetry .... %s\n"
+		"  warmup ....... %u\n"
 		""
 		, gs_app.config.size.x, gs_app.config.size.y
 		, gs_app.config.vsync
 		, gs_app.config.target_refresh_rate
 		, gs_app.config.fixed_refresh_rate
+		, gs_app.config.memory_telemetry ? APPLICATION_MEMORY_TELEMETRY_PATH : "off"
+		, gs_app.config.allocations_warmup
 	);
 
+	// setup telemetry
+	if (gs_app.config.memory_telemetry) {
+		struct CString const path = S_(APPLICATION_MEMORY_TELEMETRY_PATH);
+		platform_file_delete(path);
+		gs_app.memory_telemetry = platform_file_init(path, FILE_MODE_WRITE);
+		gs_app.memory_telemetry_buffer = buffer_init();
+		system_memory_telemetry_dump_header(&gs_app.memory_telemetry_buffer);
+	}
+
 	// setup window
 	struct Window_Config window_config = {
 		.size = gs_app.config.size,
@@ -71,6 +92,9 @@ static void application_init(void) {
 	gs_app.gpu_context = gpu_context_init(surface);
 	gpu_context_start_frame(gs_app.gpu_context, surface);
 
+	// finalize assets prepared in the background
+	system_assets_sync();
+
 	gpu_context_set_vsync(gs_app.gpu_context, gs_app.config.vsync);
 	gs_app.ticks.elapsed = get_target_ticks();
 	gs_app.ticks.fixed_accumulator = 0;
@@ -85,8 +109,12 @@ static void application_init(void) {
 
 static void application_free(void) {
 	if (gs_app.callbacks.free != NULL) { gs_app.callbacks.free(); }
+	// @note: unreferenced assets might hold GPU objects
+	system_assets_flush();
 	gpu_context_free(gs_app.gpu_context);
 	platform_window_free(gs_app.window);
+	if (gs_app.memory_telemetry != NULL) { platform_file_free(gs_app.memory_telemetry); }
+	buffer_free(&gs_app.memory_telemetry_buffer);
 	cbuffer_clear(CBM_(gs_app));
 }
 
@@ -95,8 +123,14 @@ void application_update(void) {
 	if (platform_system_is_error()) { goto exit; }
 	uint64_t const ticks_before = platform_timer_get_ticks();
 
+	// @note: steady frames are expected not to allocate
+	bool const watch_allocations = (gs_app.config.allocations_warmup > 0)
+		&& (gs_app.frame >= gs_app.config.allocations_warmup);
+	if (watch_allocations) { system_memory_watch_begin(); }
+
 	// reset per-frame data / poll platform events
 	system_memory_arena_clear();
+	system_memory_frame_swap();
 	platform_system_update();
 
 	// window might be closed by platform
@@ -113,6 +147,9 @@ void application_update(void) {
 	void * surface = platform_window_get_surface(gs_app.window);
 	gpu_context_start_frame(gs_app.gpu_context, surface);
 
+	// finalize assets prepared in the background, trim caches
+	system_assets_sync();
+
 	uint64_t const target_ticks = get_target_ticks();
 	uint64_t const fixed_ticks  = get_fixed_ticks(target_ticks);
 
@@ -134,6 +171,22 @@ void application_update(void) {
 	gpu_context_end_frame(gs_app.gpu_context);
 	platform_window_let_surface(gs_app.window, surface);
 
+	if (watch_allocations) {
+		uint32_t const allocations = system_memory_watch_end();
+		if (allocations > 0) {
+			WRN("frame %llu: %u heap allocations", (unsigned long long)gs_app.frame, allocations);
+			DEBUG_BREAK();
+		}
+	}
+
+	// @note: the buffer is reused, thus stops allocating after a few frames
+	if (gs_app.memory_telemetry != NULL) {
+		system_memory_telemetry_dump(&gs_app.memory_telemetry_buffer, gs_app.frame);
+		platform_file_write(gs_app.memory_telemetry, gs_app.memory_telemetry_buffer.data, gs_app.memory_telemetry_buffer.size);
+		buffer_clear(&gs_app.memory_telemetry_buffer);
+	}
+	gs_app.frame++;
+
 	// maintain framerate
 	uint64_t const ticks_until = ticks_before + target_ticks;
 	while (platform_timer_get_ticks() < ticks_until) {
@@ -155,6 +208,7 @@ void application_update(void) {
 	// done
 	return;
 	exit: gs_app.should_exit = true;
+	system_memory_watch_end();
 }
 
 void application_run(struct Application_Config config, struct Application_Callbacks callbacks) {
@@ -183,3 +237,5 @@ struct uvec2 application_get_screen_size(void) {
 double application_get_delta_time(void) {
 	return (double)gs_app.ticks.elapsed / (double)platform_timer_get_ticks_per_second();
 }
+
+#undef APPLICATION_MEMORY_TELEMETRY_PATH
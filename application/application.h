@@ -18,6 +18,8 @@ struct Application_Config {
 	int32_t vsync;                // 0: off; 1+: fraction of display refresh rate
 	uint32_t target_refresh_rate; // 0: as display; 1+: N times per second
 	uint32_t fixed_refresh_rate;  // 0: as target; 1+: N times per second
+	bool memory_telemetry;        // appends a CSV row per allocator each frame
+	uint32_t allocations_warmup;  // 0: off; 1+: frames until heap allocations are reported
 };
 
 struct Application_Callbacks {
@@ -2,16 +2,17 @@
 #include "framework/maths.h"
 #include "framework/json_read.h"
 
-#include "framework/platform/file.h"
 #include "framework/containers/buffer.h"
 
 #include "framework/systems/memory.h"
+#include "framework/systems/packs.h"
 #include "framework/systems/assets.h"
 #include "framework/systems/materials.h"
 
 #include "framework/graphics/gfx_objects.h"
 #include "framework/assets/mesh.h"
 #include "framework/assets/image.h"
+#include "framework/assets/cooked.h"
 #include "framework/assets/json.h"
 #include "framework/assets/typeface.h"
 #include "framework/assets/font.h"
@@ -22,25 +23,88 @@
 //
 #include "asset_types.h"
 
+// ----- ----- ----- ----- -----
+//     Asset file part
+// ----- ----- ----- ----- -----
+
+static ASSET_PREPARE(asset_file_prepare) {
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+
+	struct Buffer * result = ALLOCATE(struct Buffer);
+	*result = file_buffer;
+	return result;
+}
+
+// @note: the `cooker` tool keeps blobs fresh; release builds trust any
+//        of the current version, others hash the source and skip stale ones
+static struct Buffer asset_read_cooked(struct CString name) {
+	struct CString const cooked_suffix = S_(COOKED_SUFFIX);
+	char * cooked_name_data = ARENA_ALLOCATE_ARRAY(char, name.length + cooked_suffix.length + 1);
+	common_memcpy(cooked_name_data, name.data, name.length);
+	common_memcpy(cooked_name_data + name.length, cooked_suffix.data, cooked_suffix.length);
+	cooked_name_data[name.length + cooked_suffix.length] = '\0';
+
+	struct Buffer result = system_packs_read((struct CString){
+		.length = name.length + cooked_suffix.length,
+		.data = cooked_name_data,
+	});
+	ARENA_FREE(cooked_name_data);
+
+#if !defined(GAME_TARGET_RELEASE)
+	if (result.capacity > 0) {
+		struct Buffer source_buffer = system_packs_read(name);
+		if (source_buffer.capacity > 0) {
+			uint64_t const source_hash = hash_u64_fnv1(source_buffer.data, source_buffer.size);
+			if (cooked_get_source_hash((struct CBuffer){.size = result.size, .data = result.data}) != source_hash) {
+				WRN("cooked asset is stale: \"%.*s\"", name.length, name.data);
+				buffer_free(&result);
+			}
+		}
+		buffer_free(&source_buffer);
+	}
+#endif
+
+	return result;
+}
+
+static uint64_t asset_texture_measure(struct Handle gh_texture) {
+	struct GPU_Texture const * gpu_texture = gpu_texture_get(gh_texture);
+	if (gpu_texture == NULL) { return 0; }
+	uint64_t const size = (uint64_t)gpu_texture->size.x * gpu_texture->size.y * gfx_type_get_size(gpu_texture->format.type);
+	// @note: a full mip chain adds about a third
+	return (gpu_texture_get_levels(gpu_texture) > 1) ? size + size / 3 : size;
+}
+
 // ----- ----- ----- ----- -----
 //     Asset bytes part
 // ----- ----- ----- ----- -----
 
 static HANDLE_ACTION(asset_bytes_load) {
 	struct Asset_Bytes * asset = system_assets_get(handle);
-	struct CString const name = system_assets_get_name(handle);
-
-	struct Buffer file_buffer = platform_file_read_entire(name);
-	if (file_buffer.capacity == 0) {
+	struct Buffer * file_buffer = system_assets_get_staged(handle);
+	if (file_buffer == NULL) {
 		cbuffer_clear(CBMP_(asset));
 		return;
 	}
 
-	// @note: memory ownership transfer
+	// @note: memory ownership transfer; views into packs are copied
+	uint8_t * data = file_buffer->data;
+	if (file_buffer->allocate == NULL) {
+		data = ALLOCATE_ARRAY(uint8_t, file_buffer->size + 1);
+		common_memcpy(data, file_buffer->data, file_buffer->size + 1);
+	}
+
 	*asset = (struct Asset_Bytes){
-		.data = file_buffer.data,
-		.length = (uint32_t)file_buffer.size,
+		.data = data,
+		.length = (uint32_t)file_buffer->size,
 	};
+	FREE(file_buffer);
+}
+
+static ASSET_MEASURE(asset_bytes_measure) {
+	struct Asset_Bytes const * asset = system_assets_get(handle);
+	return asset->length;
 }
 
 static HANDLE_ACTION(asset_bytes_drop) {
@@ -55,26 +119,28 @@ static HANDLE_ACTION(asset_bytes_drop) {
 
 static HANDLE_ACTION(asset_json_load) {
 	struct Asset_JSON * asset = system_assets_get(handle);
-	struct CString const name = system_assets_get_name(handle);
-
-	struct Buffer file_buffer = platform_file_read_entire(name);
-	if (file_buffer.capacity == 0) {
+	struct Buffer * file_buffer = system_assets_get_staged(handle);
+	if (file_buffer == NULL) {
 		cbuffer_clear(CBMP_(asset));
 		return;
 	}
 
+	struct Memory_Heap * heap = system_memory_heap_init(S_("json"), NULL);
 	*asset = (struct Asset_JSON){
+		.heap = heap,
 		.value = json_parse((struct CString){
-			.length = (uint32_t)file_buffer.size,
-			.data = file_buffer.data,
-		}),
+			.length = (uint32_t)file_buffer->size,
+			.data = file_buffer->data,
+		}, NULL, system_memory_heap_get_context(heap)),
 	};
-	buffer_free(&file_buffer);
+	buffer_free(file_buffer);
+	FREE(file_buffer);
 }
 
 static HANDLE_ACTION(asset_json_drop) {
 	struct Asset_JSON * asset = system_assets_get(handle);
 	json_free(&asset->value);
+	system_memory_heap_free(asset->heap);
 	// cbuffer_clear(CBMP_(asset));
 }
 
@@ -84,19 +150,18 @@ static HANDLE_ACTION(asset_json_drop) {
 
 static HANDLE_ACTION(asset_shader_load) {
 	struct Asset_Shader * asset = system_assets_get(handle);
-	struct CString const name = system_assets_get_name(handle);
-
-	struct Buffer file_buffer = platform_file_read_entire(name);
-	if (file_buffer.capacity == 0) {
+	struct Buffer * file_buffer = system_assets_get_staged(handle);
+	if (file_buffer == NULL) {
 		cbuffer_clear(CBMP_(asset));
 		return;
 	}
 	// @todo: return error shader?
 
 	*asset = (struct Asset_Shader){
-		.gh_program = gpu_program_init(&file_buffer),
+		.gh_program = gpu_program_init(file_buffer),
 	};
-	buffer_free(&file_buffer);
+	buffer_free(file_buffer);
+	FREE(file_buffer);
 }
 
 static HANDLE_ACTION(asset_shader_drop) {
@@ -140,21 +205,39 @@ static JSON_PROCESSOR(asset_image_meta_fill) {
 	}
 }
 
+static ASSET_PREPARE(asset_image_prepare) {
+	struct Buffer cooked_buffer = asset_read_cooked(name);
+	struct CBuffer const payload = cooked_get_payload((struct CBuffer){
+		.size = cooked_buffer.size,
+		.data = cooked_buffer.data,
+	}, COOKED_TYPE_IMAGE);
+	if (payload.size > 0) {
+		struct Image * result = ALLOCATE(struct Image);
+		*result = image_init_cooked(payload);
+		buffer_free(&cooked_buffer);
+		return result;
+	}
+	buffer_free(&cooked_buffer);
+
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+
+	struct Image * result = ALLOCATE(struct Image);
+	*result = image_init(&file_buffer);
+	buffer_free(&file_buffer); // @todo: optional arena allocator?
+	return result;
+}
+
 static HANDLE_ACTION(asset_image_load) {
 	struct Asset_Image * asset = system_assets_get(handle);
-	struct CString const name = system_assets_get_name(handle);
-
-	// binary
-	struct Buffer file_buffer = platform_file_read_entire(name);
-	if (file_buffer.capacity == 0) {
+	struct Image * image = system_assets_get_staged(handle);
+	if (image == NULL) {
 		cbuffer_clear(CBMP_(asset));
 		return;
 	}
 
-	struct Image image = image_init(&file_buffer);
-	buffer_free(&file_buffer); // @todo: optional arena allocator?
-
 	// meta
+	struct CString const name = system_assets_get_name(handle);
 	struct CString const meta_suffix = S_(".meta");
 	char * meta_name_data = ARENA_ALLOCATE_ARRAY(char, name.length + meta_suffix.length + 1);
 	common_memcpy(meta_name_data, name.data, name.length);
@@ -165,14 +248,20 @@ static HANDLE_ACTION(asset_image_load) {
 		.data = meta_name_data,
 	};
 
-	process_json(meta_name, &image, asset_image_meta_fill);
+	process_json(meta_name, image, asset_image_meta_fill);
 	ARENA_FREE(meta_name_data);
 
 	// upload
 	*asset = (struct Asset_Image){
-		.gh_texture = gpu_texture_init(&image),
+		.gh_texture = gpu_texture_init(image),
 	};
-	image_free(&image); // @todo: optional arena allocator?
+	image_free(image); // @todo: optional arena allocator?
+	FREE(image);
+}
+
+static ASSET_MEASURE(asset_image_measure) {
+	struct Asset_Image const * asset = system_assets_get(handle);
+	return asset_texture_measure(asset->gh_texture);
 }
 
 static HANDLE_ACTION(asset_image_drop) {
@@ -185,18 +274,20 @@ static HANDLE_ACTION(asset_image_drop) {
 //     Asset typeface part
 // ----- ----- ----- ----- -----
 
+static ASSET_PREPARE(asset_typeface_prepare) {
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+	return typeface_init(&file_buffer);
+}
+
 static HANDLE_ACTION(asset_typeface_load) {
 	struct Asset_Typeface * asset = system_assets_get(handle);
-	struct CString const name = system_assets_get_name(handle);
-
-	struct Buffer file_buffer = platform_file_read_entire(name);
-	if (file_buffer.capacity == 0) {
+	struct Typeface * typeface = system_assets_get_staged(handle);
+	if (typeface == NULL) {
 		cbuffer_clear(CBMP_(asset));
 		return;
 	}
 
-	struct Typeface * typeface = typeface_init(&file_buffer);
-
 	*asset = (struct Asset_Typeface){
 		.typeface = typeface,
 	};
@@ -250,6 +341,11 @@ static HANDLE_ACTION(asset_font_load) {
 	process_json(name, &handle, asset_font_fill);
 }
 
+static ASSET_MEASURE(asset_font_measure) {
+	struct Asset_Font const * asset = system_assets_get(handle);
+	return asset_texture_measure(asset->gh_texture);
+}
+
 static HANDLE_ACTION(asset_font_drop) {
 	struct Asset_Font * asset = system_assets_get(handle);
 	font_free(asset->font);
@@ -269,7 +365,7 @@ static JSON_PROCESSOR(asset_target_fill) {
 	}
 
 	*context = (struct Asset_Target){
-		.gh_target = json_read_target(json),
+		.gh_target = json_load_target(json),
 	};
 }
 
@@ -289,23 +385,56 @@ static HANDLE_ACTION(asset_target_drop) {
 //     Asset model part
 // ----- ----- ----- ----- -----
 
+static ASSET_PREPARE(asset_model_prepare) {
+	struct Buffer cooked_buffer = asset_read_cooked(name);
+	struct CBuffer const payload = cooked_get_payload((struct CBuffer){
+		.size = cooked_buffer.size,
+		.data = cooked_buffer.data,
+	}, COOKED_TYPE_MESH);
+	if (payload.size > 0) {
+		struct Mesh * result = ALLOCATE(struct Mesh);
+		*result = mesh_init_cooked(payload);
+		buffer_free(&cooked_buffer);
+		return result;
+	}
+	buffer_free(&cooked_buffer);
+
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+
+	struct Mesh * result = ALLOCATE(struct Mesh);
+	*result = mesh_init(&file_buffer);
+	buffer_free(&file_buffer);
+	return result;
+}
+
 static HANDLE_ACTION(asset_model_load) {
 	struct Asset_Model * asset = system_assets_get(handle);
-	struct CString const name = system_assets_get_name(handle);
-
-	struct Buffer file_buffer = platform_file_read_entire(name);
-	if (file_buffer.capacity == 0) {
+	struct Mesh * mesh = system_assets_get_staged(handle);
+	if (mesh == NULL) {
 		cbuffer_clear(CBMP_(asset));
 		return;
 	}
 
-	struct Mesh mesh = mesh_init(&file_buffer);
-	buffer_free(&file_buffer);
-
 	*asset = (struct Asset_Model){
-		.gh_mesh = gpu_mesh_init(&mesh),
+		.gh_mesh = gpu_mesh_init(mesh),
 	};
-	mesh_free(&mesh);
+	mesh_free(mesh);
+	FREE(mesh);
+}
+
+static ASSET_MEASURE(asset_model_measure) {
+	struct Asset_Model const * asset = system_assets_get(handle);
+	struct GPU_Mesh const * gpu_mesh = gpu_mesh_get(asset->gh_mesh);
+	if (gpu_mesh == NULL) { return 0; }
+
+	uint64_t result = 0;
+	FOR_ARRAY(&gpu_mesh->buffers, it) {
+		struct GPU_Mesh_Buffer const * gpu_mesh_buffer = it.value;
+		struct GPU_Buffer const * gpu_buffer = gpu_buffer_get(gpu_mesh_buffer->gh_buffer);
+		if (gpu_buffer != NULL) { result += gpu_buffer->capacity; }
+	}
+	return result;
 }
 
 static HANDLE_ACTION(asset_model_drop) {
@@ -354,46 +483,62 @@ void asset_types_map(void) {
 }
 
 void asset_types_set(void) {
+	// @note: unmeasured types budget a count of assets; JSON DOMs share
+	//        a heap, and targets are screen-sized, thus both are not kept
 	system_assets_type_set(S_("bytes"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Bytes),
+		.budget = 4 * (1 << 20),
+		.prepare = asset_file_prepare,
 		.load = asset_bytes_load,
 		.drop = asset_bytes_drop,
+		.measure = asset_bytes_measure,
 	});
 
 	system_assets_type_set(S_("json"), (struct Asset_Info){
 		.size = sizeof(struct Asset_JSON),
+		.prepare = asset_file_prepare,
 		.load = asset_json_load,
 		.drop = asset_json_drop,
 	});
 
 	system_assets_type_set(S_("shader"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Shader),
+		.budget = 64 * sizeof(struct Asset_Shader),
+		.prepare = asset_file_prepare,
 		.load = asset_shader_load,
 		.drop = asset_shader_drop,
 	});
 
 	system_assets_type_set(S_("sampler"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Sampler),
+		.budget = 64 * sizeof(struct Asset_Sampler),
 		.load = asset_sampler_load,
 		.drop = asset_sampler_drop,
 	});
 
 	system_assets_type_set(S_("image"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Image),
+		.budget = 64 * (1 << 20),
+		.prepare = asset_image_prepare,
 		.load = asset_image_load,
 		.drop = asset_image_drop,
+		.measure = asset_image_measure,
 	});
 
 	system_assets_type_set(S_("typeface"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Typeface),
+		.budget = 8 * sizeof(struct Asset_Typeface),
+		.prepare = asset_typeface_prepare,
 		.load = asset_typeface_load,
 		.drop = asset_typeface_drop,
 	});
 
 	system_assets_type_set(S_("font"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Font),
+		.budget = 16 * (1 << 20),
 		.load = asset_font_load,
 		.drop = asset_font_drop,
+		.measure = asset_font_measure,
 	});
 
 	system_assets_type_set(S_("target"), (struct Asset_Info){
@@ -404,12 +549,16 @@ void asset_types_set(void) {
 
 	system_assets_type_set(S_("model"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Model),
+		.budget = 32 * (1 << 20),
+		.prepare = asset_model_prepare,
 		.load = asset_model_load,
 		.drop = asset_model_drop,
+		.measure = asset_model_measure,
 	});
 
 	system_assets_type_set(S_("material"), (struct Asset_Info){
 		.size = sizeof(struct Asset_Material),
+		.budget = 64 * sizeof(struct Asset_Material),
 		.load = asset_material_load,
 		.drop = asset_material_drop,
 	});
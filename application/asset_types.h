@@ -5,6 +5,7 @@
 
 struct Typeface;
 struct Font;
+struct Memory_Heap;
 
 struct Asset_Bytes {
 	uint8_t * data;
@@ -12,6 +13,7 @@ struct Asset_Bytes {
 };
 
 struct Asset_JSON {
+	struct Memory_Heap * heap; // shared by the DOMs
 	struct JSON value;
 };
 
@@ -54,39 +54,55 @@ struct Batcher_Instance {
 	uint8_t     _padding0[sizeof(float) * 3]; // to align `.quad` at 4 floats
 };
 
+//
+#include "batcher_2d.h"
+
 struct Batcher_2D {
+	struct Allocator_Context * context;
+	struct Batcher_2D_Capacity capacity;
 	struct Handle gh_mesh;
 	struct Handle gh_buffer;
 	struct Buffer buffer;
-	struct Gfx_Uniforms uniforms;
+	struct Gfx_Uniforms uniforms; // transient
 	//
 	struct vec4 color;
 	struct mat4 matrix;
 	struct Batcher_2D_Batch batch;
 	//
-	struct Array codepoints; // uint32_t
+	struct Array codepoints; // uint32_t; transient
+	struct Array glyphs;     // `struct Glyph const *`; transient, parallel to `codepoints`
 	struct Array batches;    // `struct Batcher_2D_Batch`
-	struct Array words;      // `struct Batcher_2D_Word`
+	struct Array words;      // `struct Batcher_2D_Word`; transient
 };
 
-//
-#include "batcher_2d.h"
+static void batcher_2d_reset_transient(struct Batcher_2D * batcher) {
+	struct Batcher_2D_Capacity const capacity = batcher->capacity;
+
+	batcher->codepoints = (struct Array){.allocate = realloc_frame, .value_size = sizeof(uint32_t)};
+	batcher->glyphs     = (struct Array){.allocate = realloc_frame, .value_size = sizeof(struct Glyph const *)};
+	batcher->words      = (struct Array){.allocate = realloc_frame, .value_size = sizeof(struct Batcher_2D_Word)};
+	array_ensure(&batcher->codepoints, capacity.codepoints);
+	array_ensure(&batcher->glyphs,     capacity.codepoints);
+
+	batcher->uniforms = gfx_uniforms_init_frame(capacity.uniforms, capacity.uniforms_size);
+}
 
-struct Batcher_2D * batcher_2d_init(void) {
-	struct Batcher_2D * batcher = ALLOCATE(struct Batcher_2D);
+struct Batcher_2D * batcher_2d_init(struct Allocator_Context * context) {
+	struct Batcher_2D * batcher = realloc_context(DEFAULT_REALLOCATOR, context, NULL, sizeof(struct Batcher_2D));
 	*batcher = (struct Batcher_2D){
+		.context         = context,
 		.gh_mesh         = gpu_mesh_init(&(struct Mesh){0}),
 		.gh_buffer       = gpu_buffer_init(&(struct Buffer){0}),
 		.buffer          = buffer_init(),
-		.uniforms        = gfx_uniforms_init(),
 		//
 		.color = (struct vec4){1, 1, 1, 1},
 		.matrix = c_mat4_identity,
 		//
-		.codepoints      = array_init(sizeof(uint32_t)),
 		.batches         = array_init(sizeof(struct Batcher_2D_Batch)),
-		.words           = array_init(sizeof(struct Batcher_2D_Word)),
 	};
+	batcher->buffer.context  = context;
+	batcher->batches.context = context;
+	batcher_2d_reset_transient(batcher);
 	return batcher;
 }
 
@@ -94,15 +110,20 @@ void batcher_2d_free(struct Batcher_2D * batcher) {
 	gpu_buffer_free(batcher->gh_buffer);
 	gpu_mesh_free(batcher->gh_mesh);
 	//
-	array_free(&batcher->codepoints);
 	array_free(&batcher->batches);
-	array_free(&batcher->words);
 	buffer_free(&batcher->buffer);
 	//
-	gfx_uniforms_free(&batcher->uniforms);
-	//
+	struct Allocator_Context * context = batcher->context;
 	cbuffer_clear(CBMP_(batcher));
-	FREE(batcher);
+	realloc_context(DEFAULT_REALLOCATOR, context, batcher, 0);
+}
+
+void batcher_2d_reserve(struct Batcher_2D * batcher, struct Batcher_2D_Capacity capacity) {
+	// @note: storage alignment pads batches, assume an instance each
+	buffer_ensure(&batcher->buffer, sizeof(struct Batcher_Instance) * (capacity.quads + capacity.batches));
+	array_ensure(&batcher->batches, capacity.batches);
+	batcher->capacity = capacity;
+	batcher_2d_reset_transient(batcher);
 }
 
 void batcher_2d_set_color(struct Batcher_2D * batcher, struct vec4 value) {
@@ -190,6 +211,17 @@ void batcher_2d_add_quad(
 	buffer_push_many(&batcher->buffer, sizeof(instance), &instance);
 }
 
+static void batcher_2d_fetch_glyphs(struct Batcher_2D * batcher, struct Font * font, uint32_t offset, uint32_t end, float size) {
+	// @note: pointers are valid until the font table changes
+	array_ensure(&batcher->glyphs, end);
+	batcher->glyphs.count = max_u32(batcher->glyphs.count, end);
+	font_get_glyphs(
+		font, end - offset,
+		array_at_unsafe(&batcher->codepoints, offset), size,
+		array_at_unsafe(&batcher->glyphs, offset)
+	);
+}
+
 void batcher_2d_add_text(
 	struct Batcher_2D * batcher,
 	struct rect rect, struct vec2 alignment, bool wrap,
@@ -206,6 +238,7 @@ void batcher_2d_add_text(
 	float const line_height = ascent - descent + line_gap;
 
 	uint32_t const words_offset = batcher->words.count;
+	uint32_t const text_codepoints_offset = batcher->codepoints.count;
 
 	font_add_defaults(font_asset->font, size);
 	struct Glyph const * glyph_error = font_get_glyph(font_asset->font, '\0', size);
@@ -253,6 +286,9 @@ void batcher_2d_add_text(
 		}
 	}
 
+	// @note: the table is complete for the text; look glyphs up at once
+	batcher_2d_fetch_glyphs(batcher, font_asset->font, text_codepoints_offset, batcher->codepoints.count, size);
+
 	// position words as for alignment {0, 1}
 	{
 		struct vec2 offset = {rect.min.x, rect.max.y};
@@ -274,8 +310,8 @@ void batcher_2d_add_text(
 				uint32_t const * codepoint = array_at(&batcher->codepoints, deferi);
 				uint32_t const * previous = (deferi > word->codepoints_offset) ? array_at(&batcher->codepoints, deferi - 1) : &char0;
 
-				struct Glyph const * glyph = font_get_glyph(font_asset->font, *codepoint, word->size);
-				float const full_size_x = (glyph != NULL) ? glyph->params.full_size_x : glyph_error->params.full_size_x;
+				struct Glyph const * const * glyph = array_at(&batcher->glyphs, deferi);
+				float const full_size_x = (*glyph != NULL) ? (*glyph)->params.full_size_x : glyph_error->params.full_size_x;
 
 				float const kerning = font_get_kerning(font_asset->font, *previous, *codepoint, scale);
 				offset.x += full_size_x + kerning;
@@ -361,8 +397,8 @@ void batcher_2d_add_text(
 			uint32_t const * codepoint = array_at(&batcher->codepoints, deferi);
 			uint32_t const * previous = (deferi > word->codepoints_offset) ? array_at(&batcher->codepoints, deferi - 1) : &char0;
 
-			struct Glyph const * glyph = font_get_glyph(font_asset->font, *codepoint, word->size);
-			struct Glyph_Params const params = (glyph != NULL) ? glyph->params : glyph_error->params;
+			struct Glyph const * const * glyph = array_at(&batcher->glyphs, deferi);
+			struct Glyph_Params const params = (*glyph != NULL) ? (*glyph)->params : glyph_error->params;
 
 			float const kerning = font_get_kerning(font_asset->font, *previous, *codepoint, scale);
 			float const offset_x = offset.x + kerning;
@@ -429,13 +465,16 @@ static void batcher_2d_bake_words(struct Batcher_2D * batcher) {
 		struct Glyph const * glyph_error = font_get_glyph(font_asset->font, '\0', word->size);
 		struct rect const glyph_error_uv = glyph_error->uv;
 
+		// @note: rendering might have changed the table, look glyphs up anew
+		batcher_2d_fetch_glyphs(batcher, font_asset->font, word->codepoints_offset, word->codepoints_end, word->size);
+
 		for (uint32_t i = word->codepoints_offset; i < word->codepoints_end; i++) {
 			uint32_t const * codepoint = array_at(&batcher->codepoints, i);
 
 			if (codepoint_is_invisible(*codepoint)) { continue; }
 
-			struct Glyph const * glyph = font_get_glyph(font_asset->font, *codepoint, word->size);
-			struct rect const uv = (glyph != NULL) ? glyph->uv : glyph_error_uv;
+			struct Glyph const * const * glyph = array_at(&batcher->glyphs, i);
+			struct rect const uv = (*glyph != NULL) ? (*glyph)->uv : glyph_error_uv;
 
 			struct Batcher_Instance * instance = buffer_at(&batcher->buffer, b_offset);
 			instance->uv = uv;
@@ -447,11 +486,9 @@ static void batcher_2d_bake_words(struct Batcher_2D * batcher) {
 
 void batcher_2d_clear(struct Batcher_2D * batcher) {
 	cbuffer_clear(CBM_(batcher->batch));
-	array_clear(&batcher->codepoints);
 	array_clear(&batcher->batches);
-	array_clear(&batcher->words);
 	buffer_clear(&batcher->buffer);
-	gfx_uniforms_clear(&batcher->uniforms);
+	batcher_2d_reset_transient(batcher);
 }
 
 void batcher_2d_issue_commands(struct Batcher_2D * batcher, struct Array * gpu_commands) {
@@ -7,9 +7,20 @@
 struct Batcher_2D;
 struct Array;
 
-struct Batcher_2D * batcher_2d_init(void);
+struct Batcher_2D * batcher_2d_init(struct Allocator_Context * context);
 void batcher_2d_free(struct Batcher_2D * batcher);
 
+// @note: see `Renderer_Capacity`
+struct Batcher_2D_Capacity {
+	uint32_t quads;
+	uint32_t codepoints;    // of texts, also bounds words
+	uint32_t batches;
+	uint32_t uniforms;
+	size_t uniforms_size;   // bytes
+};
+
+void batcher_2d_reserve(struct Batcher_2D * batcher, struct Batcher_2D_Capacity capacity);
+
 void batcher_2d_set_color(struct Batcher_2D * batcher, struct vec4 const value);
 void batcher_2d_set_matrix(struct Batcher_2D * batcher, struct mat4 const value);
 void batcher_2d_set_material(struct Batcher_2D * batcher, struct Handle handle);
@@ -3,6 +3,7 @@
 #include "framework/json_read.h"
 
 #include "framework/containers/buffer.h"
+#include "framework/containers/array.h"
 #include "framework/containers/hashmap.h"
 
 #include "framework/systems/memory.h"
@@ -21,6 +22,7 @@
 #include "json_load.h"
 
 static void json_fill_uniforms(struct JSON const * json, struct Gfx_Material * material);
+
 struct Handle json_load_gfx_material(struct JSON const * json) {
 	struct Handle ms_handle = system_materials_aquire();
 	if (json->type != JSON_OBJECT) { goto fail; }
@@ -56,6 +58,42 @@ struct Handle json_load_font_range(struct JSON const * json, uint32_t * from, ui
 	return system_assets_load(path);
 }
 
+struct Handle json_load_target(struct JSON const * json) {
+	if (json->type != JSON_OBJECT) { goto fail; }
+
+	struct JSON const * buffers_json = json_get(json, S_("buffers"));
+	if (buffers_json->type != JSON_ARRAY) { goto fail; }
+
+	struct Array formats = array_init(sizeof(struct Target_Format));
+	formats.allocate = realloc_arena;
+
+	uint32_t const buffers_count = json_count(buffers_json);
+	for (uint32_t i = 0; i < buffers_count; i++) {
+		struct Target_Format const format = json_read_target_format(json_at(buffers_json, i));
+		array_push_many(&formats, 1, &format);
+	}
+
+	struct Handle result = (struct Handle){0};
+	if (formats.count > 0) {
+		struct uvec2 size = {0};
+		json_read_many_u32(json_get(json, S_("size")), 2, &size.x);
+		if (size.x > 0 && size.y > 0) {
+			result = gpu_target_init(&(struct GPU_Target_Asset){
+				.size = size,
+				.formats = formats,
+			});
+		}
+	}
+
+	array_free(&formats);
+	return result;
+
+	// process errors
+	fail: ERR("failed to load target asset");
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	return (struct Handle){0};
+}
+
 //
 
 static struct Handle json_load_texture(struct JSON const * json) {
@@ -7,5 +7,6 @@ struct Font;
 
 struct Handle json_load_gfx_material(struct JSON const * json);
 struct Handle json_load_font_range(struct JSON const * json, uint32_t * from, uint32_t * to);
+struct Handle json_load_target(struct JSON const * json);
 
 #endif
@@ -0,0 +1,72 @@
+#include "framework/json_read.h"
+
+#include "framework/containers/array.h"
+
+#include "framework/systems/strings.h"
+#include "framework/systems/assets.h"
+
+#include "framework/assets/json.h"
+
+
+//
+#include "json_preload.h"
+
+struct JSON_Preload {
+	struct Array * handles; // asset `struct Handle`
+	struct Array visited;   // path `struct Handle`
+};
+
+static JSON_PROCESSOR(json_preload_value);
+void json_load_preload(struct JSON const * json, struct Array * handles) {
+	struct JSON_Preload context = {
+		.handles = handles,
+		.visited = array_init(sizeof(struct Handle)),
+	};
+	json_preload_value(json, &context);
+	array_free(&context.visited);
+}
+
+//
+
+static JSON_PROCESSOR(json_preload_value) {
+	struct JSON_Preload * context = data;
+
+	switch (json->type) {
+		default: break;
+
+		case JSON_OBJECT: {
+			FOR_DICTIONARY(&json->as.table, it) {
+				json_preload_value(it.value, context);
+			}
+		} break;
+
+		case JSON_ARRAY: {
+			FOR_ARRAY(&json->as.array, it) {
+				json_preload_value(it.value, context);
+			}
+		} break;
+
+		case JSON_STRING: {
+			struct Handle const sh_path = json->as.sh_string;
+			FOR_ARRAY(&context->visited, it) {
+				struct Handle const * sh_visited = it.value;
+				if (handle_equals(*sh_visited, sh_path)) { return; }
+			}
+
+			// @note: loaded assets have got their dependencies already
+			struct CString const path = system_strings_get(sh_path);
+			struct Asset_Info const * info = system_assets_get_info(path);
+			if (info == NULL) { return; }
+			if (!handle_is_null(system_assets_find(path))) { return; }
+			array_push_many(&context->visited, 1, &sh_path);
+
+			// @note: the leaves are prepared in parallel, while the others are
+			//        expected to be JSON descriptors, referring to their dependencies
+			if (info->prepare != NULL) {
+				struct Handle const ah_asset = system_assets_load_async(path);
+				array_push_many(context->handles, 1, &ah_asset);
+			}
+			else { process_json(path, context, json_preload_value); }
+		} break;
+	}
+}
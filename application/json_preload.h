@@ -0,0 +1,12 @@
+#if !defined(APPLICATION_JSON_PRELOAD)
+#define APPLICATION_JSON_PRELOAD
+
+#include "framework/common.h"
+
+struct Array;
+
+// @note: walks the value and the descriptors it refers to, starting asynchronous
+//        loads of the preparable assets found; pushes their handles to drop later
+void json_load_preload(struct JSON const * json, struct Array * handles);
+
+#endif
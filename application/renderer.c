@@ -2,6 +2,8 @@
 #include "framework/maths.h"
 #include "framework/parsing.h"
 
+#include "framework/systems/memory.h"
+
 #include "framework/graphics/gfx_objects.h"
 #include "framework/graphics/command.h"
 
@@ -16,16 +18,27 @@
 
 struct Renderer gs_renderer;
 
+static void renderer_reset_transient(void) {
+	gs_renderer.uniforms = gfx_uniforms_init_frame(gs_renderer.capacity.uniforms, gs_renderer.capacity.uniforms_size);
+}
+
 void renderer_init(void) {
+	struct Memory_Heap * heap = system_memory_heap_init(S_("renderer"), NULL);
+	struct Allocator_Context * context = system_memory_heap_get_context(heap);
+
 	gs_renderer = (struct Renderer){
-		.batcher_2d = batcher_2d_init(),
+		.heap = heap,
+		.batcher_2d = batcher_2d_init(context),
 		.global = buffer_init(),
 		.gh_global = gpu_buffer_init(&(struct Buffer){0}),
 		.camera = buffer_init(),
 		.gh_camera = gpu_buffer_init(&(struct Buffer){0}),
-		.uniforms = gfx_uniforms_init(),
 		.gpu_commands = array_init(sizeof(struct GPU_Command)),
 	};
+	gs_renderer.global.context       = context;
+	gs_renderer.camera.context       = context;
+	gs_renderer.gpu_commands.context = context;
+	renderer_reset_transient();
 }
 
 void renderer_free(void) {
@@ -34,16 +47,25 @@ void renderer_free(void) {
 	gpu_buffer_free(gs_renderer.gh_global);
 	buffer_free(&gs_renderer.camera);
 	gpu_buffer_free(gs_renderer.gh_camera);
-	gfx_uniforms_free(&gs_renderer.uniforms);
 	array_free(&gs_renderer.gpu_commands);
+	system_memory_heap_free(gs_renderer.heap);
 	cbuffer_clear(CBM_(gs_renderer));
 }
 
+void renderer_reserve(struct Renderer_Capacity capacity) {
+	gs_renderer.capacity = capacity;
+	batcher_2d_reserve(gs_renderer.batcher_2d, capacity.batcher_2d);
+	buffer_ensure(&gs_renderer.global, capacity.global_size);
+	buffer_ensure(&gs_renderer.camera, capacity.camera_size);
+	array_ensure(&gs_renderer.gpu_commands, capacity.gpu_commands);
+	renderer_reset_transient();
+}
+
 void renderer_start_frame(void) {
 	batcher_2d_clear(gs_renderer.batcher_2d);
 	buffer_clear(&gs_renderer.global);
 	buffer_clear(&gs_renderer.camera);
-	gfx_uniforms_clear(&gs_renderer.uniforms);
+	renderer_reset_transient();
 	array_clear(&gs_renderer.gpu_commands);
 }
 
@@ -4,16 +4,30 @@
 #include "framework/containers/array.h"
 #include "framework/containers/buffer.h"
 #include "framework/graphics/gfx_material.h"
+#include "application/batcher_2d.h"
 
-struct Batcher_2D;
+struct Memory_Heap;
+
+// @note: pre-sizes per frame containers, so that steady frames do not allocate;
+// transient ones are re-sized every frame, within the frame arena
+struct Renderer_Capacity {
+	uint32_t gpu_commands;
+	uint32_t uniforms;
+	size_t uniforms_size; // bytes
+	size_t global_size;   // bytes
+	size_t camera_size;   // bytes
+	struct Batcher_2D_Capacity batcher_2d;
+};
 
 extern struct Renderer {
+	struct Memory_Heap * heap;
+	struct Renderer_Capacity capacity;
 	struct Batcher_2D * batcher_2d;
 	struct Buffer global;
 	struct Handle gh_global;
 	struct Buffer camera;
 	struct Handle gh_camera;
-	struct Gfx_Uniforms uniforms;
+	struct Gfx_Uniforms uniforms; // transient
 	struct Array gpu_commands; // `struct GPU_Command`
 } gs_renderer;
 
@@ -22,6 +36,8 @@ extern struct Renderer {
 void renderer_init(void);
 void renderer_free(void);
 
+void renderer_reserve(struct Renderer_Capacity capacity);
+
 void renderer_start_frame(void);
 void renderer_end_frame(void);
 
@@ -0,0 +1,41 @@
+#include "framework/containers/buffer.h"
+
+
+//
+#include "cooked.h"
+
+#define COOKED_MAGIC 0x4B4F4F43 // "COOK"
+
+void cooked_init(struct Buffer * blob, enum Cooked_Type type, uint64_t source_hash) {
+	buffer_push_many(blob, sizeof(struct Cooked_Header), &(struct Cooked_Header){
+		.magic       = COOKED_MAGIC,
+		.version     = COOKED_VERSION,
+		.type        = (uint32_t)type,
+		.source_hash = source_hash,
+	});
+}
+
+struct CBuffer cooked_get_payload(struct CBuffer blob, enum Cooked_Type type) {
+	if (blob.size < sizeof(struct Cooked_Header)) { return (struct CBuffer){0}; }
+
+	struct Cooked_Header header;
+	common_memcpy(&header, blob.data, sizeof(header));
+	if (header.magic   != COOKED_MAGIC)   { return (struct CBuffer){0}; }
+	if (header.version != COOKED_VERSION) { return (struct CBuffer){0}; }
+	if (header.type    != (uint32_t)type) { return (struct CBuffer){0}; }
+
+	return (struct CBuffer){
+		.size = blob.size - sizeof(header),
+		.data = (uint8_t const *)blob.data + sizeof(header),
+	};
+}
+
+uint64_t cooked_get_source_hash(struct CBuffer blob) {
+	if (blob.size < sizeof(struct Cooked_Header)) { return 0; }
+
+	struct Cooked_Header header;
+	common_memcpy(&header, blob.data, sizeof(header));
+	return header.source_hash;
+}
+
+#undef COOKED_MAGIC
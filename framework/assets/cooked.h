@@ -0,0 +1,32 @@
+#if !defined(FRAMEWORK_system_assets_COOKED)
+#define FRAMEWORK_system_assets_COOKED
+
+#include "framework/common.h"
+
+struct Buffer;
+
+// @note: a cooked blob is a load-ready form of a source asset, stored
+//        next to it with `COOKED_SUFFIX`; the `cooker` tool rebuilds blobs
+//        whose version or source hash differ
+#define COOKED_SUFFIX  ".cooked"
+#define COOKED_VERSION 1
+
+enum Cooked_Type {
+	COOKED_TYPE_NONE,
+	COOKED_TYPE_IMAGE,
+	COOKED_TYPE_MESH,
+};
+
+struct Cooked_Header {
+	uint32_t magic, version;
+	uint32_t type, reserved;
+	uint64_t source_hash;
+};
+
+void cooked_init(struct Buffer * blob, enum Cooked_Type type, uint64_t source_hash);
+
+// @note: empty unless the blob is of the current version and of the `type`
+struct CBuffer cooked_get_payload(struct CBuffer blob, enum Cooked_Type type);
+uint64_t cooked_get_source_hash(struct CBuffer blob);
+
+#endif
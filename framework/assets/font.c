@@ -20,6 +20,7 @@ struct Typeface_Range {
 };
 
 struct Font {
+	struct Memory_Heap * heap; // shared by the fonts
 	struct Image buffer;
 	//
 	struct Array ranges;  // `struct Typeface_Range`
@@ -45,6 +46,13 @@ static HASHER(hash_typeface_key) {
 //
 #include "font.h"
 
+#define HASHMAP_TYPED_NAME   typeface_key_glyph
+#define HASHMAP_TYPED_KEY    struct Typeface_Key
+#define HASHMAP_TYPED_VALUE  struct Glyph
+#define HASHMAP_TYPED_HASHER hash_typeface_key
+#define HASHMAP_TYPED_EQUALS(key1, key2) ((key1)->codepoint == (key2)->codepoint && bits_r32_u32((key1)->size) == bits_r32_u32((key2)->size))
+#include "framework/containers/hashmap_typed.h"
+
 struct Symbol_To_Render {
 	struct Typeface_Key key;
 	struct Glyph * glyph; // @note: a short-lived pointer into a `font` table
@@ -55,8 +63,12 @@ struct Glyph_Codepoint {
 };
 
 struct Font * font_init(void) {
-	struct Font * font = ALLOCATE(struct Font);
+	struct Memory_Heap * heap = system_memory_heap_init(S_("fonts"), NULL);
+	struct Allocator_Context * context = system_memory_heap_get_context(heap);
+
+	struct Font * font = realloc_context(DEFAULT_REALLOCATOR, context, NULL, sizeof(struct Font));
 	*font = (struct Font){
+		.heap = heap,
 		.buffer = {
 			.format = {
 				.flags = TEXTURE_FLAG_COLOR,
@@ -72,8 +84,11 @@ struct Font * font_init(void) {
 			},
 		},
 		.ranges = array_init(sizeof(struct Typeface_Range)),
-		.table = hashmap_init(&hash_typeface_key, sizeof(struct Typeface_Key), sizeof(struct Glyph)),
+		.table = hashmap_typeface_key_glyph_init(),
 	};
+	font->ranges.context = context;
+	font->table.context = context;
+	font->table.flags = HASHMAP_FLAG_PACKED;
 	return font;
 }
 
@@ -83,8 +98,10 @@ void font_free(struct Font * font) {
 	array_free(&font->ranges);
 	hashmap_free(&font->table);
 
+	struct Memory_Heap * heap = font->heap;
 	cbuffer_clear(CBMP_(font));
-	FREE(font);
+	realloc_context(DEFAULT_REALLOCATOR, system_memory_heap_get_context(heap), font, 0);
+	system_memory_heap_free(heap);
 }
 
 struct Typeface const * font_get_typeface(struct Font const * font, uint32_t codepoint) {
@@ -111,7 +128,7 @@ void font_add_glyph(struct Font * font, uint32_t codepoint, float size) {
 		.codepoint = codepoint,
 		.size = size,
 	};
-	struct Glyph * glyph = hashmap_get(&font->table, &key);
+	struct Glyph * glyph = hashmap_typeface_key_glyph_get(&font->table, &key);
 	if (glyph != NULL) { glyph->gc_timeout = GLYPH_GC_TIMEOUT_MAX; return; }
 
 	struct Typeface const * typeface = font_get_typeface(font, codepoint);
@@ -124,7 +141,7 @@ void font_add_glyph(struct Font * font, uint32_t codepoint, float size) {
 		typeface, glyph_id, typeface_get_scale(typeface, size)
 	);
 
-	hashmap_set(&font->table, &key, &(struct Glyph){
+	hashmap_typeface_key_glyph_set(&font->table, &key, &(struct Glyph){
 		.params = glyph_params,
 		.id = glyph_id,
 		.gc_timeout = GLYPH_GC_TIMEOUT_MAX,
@@ -139,10 +156,10 @@ static void font_add_default(struct Font *font, uint32_t codepoint, float size,
 		.size = size,
 	};
 
-	struct Glyph * glyph = hashmap_get(&font->table, &key);
+	struct Glyph * glyph = hashmap_typeface_key_glyph_get(&font->table, &key);
 	if (glyph != NULL) { glyph->gc_timeout = GLYPH_GC_TIMEOUT_MAX; return; }
 
-	hashmap_set(&font->table, &key, &(struct Glyph){
+	hashmap_typeface_key_glyph_set(&font->table, &key, &(struct Glyph){
 		.params = (struct Glyph_Params){
 			.full_size_x = full_size_x,
 			.rect = rect,
@@ -386,12 +403,32 @@ struct Image const * font_get_asset(struct Font const * font) {
 }
 
 struct Glyph const * font_get_glyph(struct Font * const font, uint32_t codepoint, float size) {
-	return hashmap_get(&font->table, &(struct Typeface_Key){
+	return hashmap_typeface_key_glyph_get(&font->table, &(struct Typeface_Key){
 		.codepoint = codepoint,
 		.size = size,
 	});
 }
 
+void font_get_glyphs(struct Font * const font, uint32_t count, uint32_t const * codepoints, float size, struct Glyph const ** glyphs) {
+	// @note: keys and values are laid out by chunks, to stay off the heap
+	struct Typeface_Key keys[64];
+	void * values[SIZE_OF_ARRAY(keys)];
+	uint32_t const keys_count = (uint32_t)SIZE_OF_ARRAY(keys);
+	for (uint32_t offset = 0; offset < count; offset += keys_count) {
+		uint32_t const batch = min_u32(count - offset, keys_count);
+		for (uint32_t i = 0; i < batch; i++) {
+			keys[i] = (struct Typeface_Key){
+				.codepoint = codepoints[offset + i],
+				.size = size,
+			};
+		}
+		hashmap_get_many(&font->table, batch, keys, values);
+		for (uint32_t i = 0; i < batch; i++) {
+			glyphs[offset + i] = values[i];
+		}
+	}
+}
+
 // 
 
 float font_get_scale(struct Font const * font, float size) {
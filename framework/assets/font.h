@@ -39,6 +39,7 @@ void font_render(struct Font * font);
 
 struct Image const * font_get_asset(struct Font const * font);
 struct Glyph const * font_get_glyph(struct Font * const font, uint32_t codepoint, float size);
+void font_get_glyphs(struct Font * const font, uint32_t count, uint32_t const * codepoints, float size, struct Glyph const ** glyphs);
 
 float font_get_scale(struct Font const * font, float size);
 float font_get_ascent(struct Font const * font, float scale);
@@ -4,13 +4,17 @@
 #include "framework/containers/buffer.h"
 #include "framework/systems/memory.h"
 
+// @note: pixels start aligned for SIMD loads
+#define IMAGE_ALIGNMENT 32
+#define IMAGE_REALLOCATE(pointer, size) realloc_aligned(DEFAULT_REALLOCATOR, NULL, pointer, size, IMAGE_ALIGNMENT)
+
 #include "framework/__warnings_push.h"
 	#define STBI_NO_STDIO
 	#define STBI_ONLY_PNG
 
-	#define STBI_MALLOC(size)           REALLOCATE(NULL,    size)
-	#define STBI_REALLOC(pointer, size) REALLOCATE(pointer, size)
-	#define STBI_FREE(pointer)          REALLOCATE(pointer, 0)
+	#define STBI_MALLOC(size)           IMAGE_REALLOCATE(NULL,    size)
+	#define STBI_REALLOC(pointer, size) IMAGE_REALLOCATE(pointer, size)
+	#define STBI_FREE(pointer)          IMAGE_REALLOCATE(pointer, 0)
 
 	#define STB_IMAGE_STATIC
 	#define STB_IMAGE_IMPLEMENTATION
@@ -40,7 +44,7 @@ struct Image image_init(struct Buffer const * buffer) {
 }
 
 void image_free(struct Image * image) {
-	FREE(image->data);
+	IMAGE_REALLOCATE(image->data, 0);
 	cbuffer_clear(CBMP_(image));
 }
 
@@ -49,8 +53,52 @@ void image_ensure(struct Image * image, struct uvec2 size) {
 	uint32_t const data_size = gfx_type_get_size(image->format.type);
 	uint32_t const target_capacity = size.x * size.y * channels;
 	if (image->capacity < target_capacity) {
-		image->data = REALLOCATE(image->data, size.x * size.y * data_size);
+		image->data = IMAGE_REALLOCATE(image->data, size.x * size.y * data_size);
 		image->capacity = target_capacity;
 	}
 	image->size = size;
 }
+
+//
+
+struct Image_Cooked {
+	struct uvec2 size;
+	struct Texture_Format format;
+};
+
+struct Image image_init_cooked(struct CBuffer payload) {
+	struct Image_Cooked cooked;
+	if (payload.size < sizeof(cooked)) { return (struct Image){0}; }
+	common_memcpy(&cooked, payload.data, sizeof(cooked));
+
+	size_t const data_size = payload.size - sizeof(cooked);
+	uint64_t const expected_size = (uint64_t)cooked.size.x * cooked.size.y * gfx_type_get_size(cooked.format.type);
+	if (data_size != expected_size) { goto fail; }
+
+	void * data = IMAGE_REALLOCATE(NULL, data_size);
+	common_memcpy(data, (uint8_t const *)payload.data + sizeof(cooked), data_size);
+
+	return (struct Image){
+		.capacity = cooked.size.x * cooked.size.y,
+		.size = cooked.size,
+		.data = data,
+		.format = cooked.format,
+	};
+
+	fail:
+	ERR("failure: malformed cooked image");
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	return (struct Image){0};
+}
+
+void image_cook(struct Image const * image, struct Buffer * payload) {
+	size_t const data_size = (size_t)image->size.x * image->size.y * gfx_type_get_size(image->format.type);
+	buffer_push_many(payload, sizeof(struct Image_Cooked), &(struct Image_Cooked){
+		.size = image->size,
+		.format = image->format,
+	});
+	buffer_push_many(payload, data_size, image->data);
+}
+
+#undef IMAGE_ALIGNMENT
+#undef IMAGE_REALLOCATE
@@ -27,4 +27,8 @@ void image_free(struct Image * image);
 
 void image_ensure(struct Image * image, struct uvec2 size);
 
+// @note: cooked payloads keep decoded pixels; settings come from `.meta`
+struct Image image_init_cooked(struct CBuffer payload);
+void image_cook(struct Image const * image, struct Buffer * payload);
+
 #endif
@@ -21,9 +21,9 @@ void json_free(struct JSON * value) {
 		default: break;
 
 		case JSON_OBJECT: {
-			struct Hashmap * table = &value->as.table;
-			FOR_HASHMAP(table, it) { json_free(it.value); }
-			hashmap_free(table);
+			struct Dictionary * table = &value->as.table;
+			FOR_DICTIONARY(table, it) { json_free(it.value); }
+			dictionary_free(table);
 		} break;
 
 		case JSON_ARRAY: {
@@ -42,7 +42,7 @@ struct JSON const * json_get(struct JSON const * value, struct CString key) {
 	}
 	struct Handle const sh_key = system_strings_find(key);
 	if (handle_is_null(sh_key)) { return &c_json_null; }
-	void const * result = hashmap_get(&value->as.table, &sh_key);
+	void const * result = dictionary_get(&value->as.table, &sh_key);
 	return (result != NULL) ? result : &c_json_null;
 }
 
@@ -108,6 +108,8 @@ bool json_at_boolean(struct JSON const * value, uint32_t index) {
 #include "internal/json_lexer.h"
 
 struct JSON_Parser {
+	Allocator * allocate;
+	struct Allocator_Context * context;
 	struct JSON_Lexer lexer;
 	struct JSON_Token previous, current;
 	bool error, panic;
@@ -193,8 +195,10 @@ static void json_parser_synchronize_array(struct JSON_Parser * parser) {
 static void json_parser_do_value(struct JSON_Parser * parser, struct JSON * value);
 static void json_parser_do_object(struct JSON_Parser * parser, struct JSON * value) {
 	*value = (struct JSON){.type = JSON_OBJECT};
-	struct Hashmap * table = &value->as.table;
-	*table = hashmap_init(&hash32, sizeof(struct Handle), sizeof(struct JSON));
+	struct Dictionary * table = &value->as.table;
+	*table = dictionary_init(&hash32, sizeof(struct Handle), sizeof(struct JSON));
+	table->allocate = parser->allocate;
+	table->context = parser->context;
 
 	enum JSON_Token_Type const scope = JSON_TOKEN_RIGHT_BRACE;
 	if (parser->current.type == scope) { json_parser_consume(parser); return; }
@@ -220,7 +224,7 @@ static void json_parser_do_object(struct JSON_Parser * parser, struct JSON * val
 		}
 
 		// add
-		bool const is_new = hashmap_set(table, &entry_key.as.sh_string, &entry_value);
+		bool const is_new = dictionary_set(table, &entry_key.as.sh_string, &entry_value);
 		if (!is_new) {
 			struct CString const key = system_strings_get(entry_key.as.sh_string);
 			WRN("key duplicate: \"%.*s\"", key.length, key.data);
@@ -242,6 +246,8 @@ static void json_parser_do_array(struct JSON_Parser * parser, struct JSON * valu
 	*value = (struct JSON){.type = JSON_ARRAY};
 	struct Array * array = &value->as.array;
 	*array = array_init(sizeof(struct JSON));
+	array->allocate = parser->allocate;
+	array->context = parser->context;
 
 	enum JSON_Token_Type const scope = JSON_TOKEN_RIGHT_SQUARE;
 	if (parser->current.type == scope) { json_parser_consume(parser); return; }
@@ -311,8 +317,10 @@ static void json_parser_do_value(struct JSON_Parser * parser, struct JSON * valu
 	*value = c_json_error;
 }
 
-struct JSON json_parse(struct CString text) {
+struct JSON json_parse(struct CString text, Allocator * allocate, struct Allocator_Context * context) {
 	struct JSON_Parser parser = {
+		.allocate = allocate,
+		.context = context,
 		.lexer = json_lexer_init(text),
 	};
 	json_parser_consume(&parser);
@@ -2,7 +2,7 @@
 #define FRAMEWORK_system_assets_JSON
 
 #include "framework/containers/array.h"
-#include "framework/containers/hashmap.h"
+#include "framework/containers/dictionary.h"
 
 struct Strings;
 
@@ -19,7 +19,7 @@ enum JSON_Type {
 struct JSON {
 	enum JSON_Type type;
 	union {
-		struct Hashmap table;     // key `struct Handle` : `struct JSON`
+		struct Dictionary table;  // key `struct Handle` : `struct JSON`, in source order
 		struct Array   array;     // `struct JSON`
 		struct Handle  sh_string; // get `struct CString` via `system_strings_get`
 		double         number;
@@ -54,7 +54,9 @@ bool json_at_boolean(struct JSON const * value, uint32_t index);
 //     parsing
 // ----- ----- ----- ----- -----
 
-struct JSON json_parse(struct CString text);
+// @note: `allocate` is used for objects and arrays, `NULL` stands for the default one;
+// the `context`, if any, overrides it, say, with a heap for the whole DOM
+struct JSON json_parse(struct CString text, Allocator * allocate, struct Allocator_Context * context);
 
 // ----- ----- ----- ----- -----
 //     constants
@@ -29,6 +29,68 @@ void mesh_free(struct Mesh * mesh) {
 	cbuffer_clear(CBMP_(mesh));
 }
 
+struct Mesh_Buffer_Cooked {
+	struct Mesh_Format format;
+	struct Mesh_Attributes attributes;
+	uint32_t is_index, reserved;
+	uint64_t size;
+};
+
+struct Mesh mesh_init_cooked(struct CBuffer payload) {
+	uint8_t const * cursor = payload.data;
+	uint8_t const * const end = cursor + payload.size;
+
+	uint32_t count;
+	if ((size_t)(end - cursor) < sizeof(count)) { return (struct Mesh){0}; }
+	common_memcpy(&count, cursor, sizeof(count));
+	cursor += sizeof(count);
+
+	struct Mesh mesh = {
+		.buffers = array_init(sizeof(struct Mesh_Buffer)),
+	};
+	array_resize(&mesh.buffers, count);
+	for (uint32_t i = 0; i < count; i++) {
+		struct Mesh_Buffer_Cooked cooked;
+		if ((size_t)(end - cursor) < sizeof(cooked)) { goto fail; }
+		common_memcpy(&cooked, cursor, sizeof(cooked));
+		cursor += sizeof(cooked);
+
+		if ((uint64_t)(end - cursor) < cooked.size) { goto fail; }
+		struct Buffer buffer = buffer_init();
+		buffer_push_many(&buffer, (size_t)cooked.size, cursor);
+		cursor += cooked.size;
+
+		array_push_many(&mesh.buffers, 1, &(struct Mesh_Buffer){
+			.buffer = buffer,
+			.format = cooked.format,
+			.attributes = cooked.attributes,
+			.is_index = cooked.is_index != 0,
+		});
+	}
+
+	return mesh;
+
+	fail:
+	ERR("failure: malformed cooked mesh");
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	mesh_free(&mesh);
+	return (struct Mesh){0};
+}
+
+void mesh_cook(struct Mesh const * mesh, struct Buffer * payload) {
+	buffer_push_many(payload, sizeof(mesh->buffers.count), &mesh->buffers.count);
+	FOR_ARRAY(&mesh->buffers, it) {
+		struct Mesh_Buffer const * mesh_buffer = it.value;
+		buffer_push_many(payload, sizeof(struct Mesh_Buffer_Cooked), &(struct Mesh_Buffer_Cooked){
+			.format = mesh_buffer->format,
+			.attributes = mesh_buffer->attributes,
+			.is_index = mesh_buffer->is_index,
+			.size = mesh_buffer->buffer.size,
+		});
+		buffer_push_many(payload, mesh_buffer->buffer.size, mesh_buffer->buffer.data);
+	}
+}
+
 //
 
 static struct Mesh mesh_init_wfobj(struct Buffer const * source) {
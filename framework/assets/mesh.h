@@ -19,4 +19,8 @@ struct Mesh {
 struct Mesh mesh_init(struct Buffer const * source);
 void mesh_free(struct Mesh * mesh);
 
+// @note: cooked payloads keep repacked buffers
+struct Mesh mesh_init_cooked(struct CBuffer payload);
+void mesh_cook(struct Mesh const * mesh, struct Buffer * payload);
+
 #endif
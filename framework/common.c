@@ -133,6 +133,16 @@ void common_memcpy(void * target, void const * source, size_t size) {
 	memcpy(target, source, size);
 }
 
+void common_memmove(void * target, void const * source, size_t size) {
+	if (source == NULL) { return; }
+	memmove(target, source, size);
+}
+
+void common_memset(void * target, uint8_t value, size_t size) {
+	if (target == NULL) { return; }
+	memset(target, value, size);
+}
+
 void common_qsort(void * data, size_t count, size_t value_size, Comparator * compare) {
 	qsort(data, count, value_size, compare);
 }
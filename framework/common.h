@@ -31,6 +31,12 @@
 	#define PRINTF_LIKE(position, count)
 #endif // __clang__
 
+#if defined(_MSC_VER)
+	#define THREAD_LOCAL __declspec(thread)
+#else
+	#define THREAD_LOCAL __thread
+#endif
+
 #if __STDC_VERSION__ >= 199901L
 	#define FLEXIBLE_ARRAY
 #endif
@@ -50,6 +56,7 @@
 // ----- ----- ----- ----- -----
 
 struct JSON;
+struct Allocator_Context;
 
 // ----- ----- ----- ----- -----
 //     conversion
@@ -111,6 +118,14 @@ typedef COMPARATOR(Comparator);
 #define ALLOCATOR(func) void * (func)(void * pointer, size_t size)
 typedef ALLOCATOR(Allocator);
 
+#define CONTEXT_ALLOCATOR(func) void * (func)(struct Allocator_Context * context, void * pointer, size_t size)
+typedef CONTEXT_ALLOCATOR(Context_Allocator);
+
+// @note: an allocator with a state; embed it as the first member of the latter
+struct Allocator_Context {
+	Context_Allocator * invoke;
+};
+
 #define HASHER(func) uint32_t (func)(void const * value)
 typedef HASHER(Hasher);
 
@@ -207,6 +222,8 @@ void common_exit_success(void);
 void common_exit_failure(void);
 
 void common_memcpy(void * target, void const * source, size_t size);
+void common_memmove(void * target, void const * source, size_t size);
+void common_memset(void * target, uint8_t value, size_t size);
 void common_qsort(void * data, size_t count, size_t value_size, Comparator * compare);
 char const * common_strstr(char const * buffer, char const * value);
 
@@ -16,7 +16,7 @@ struct Array array_init(uint32_t value_size) {
 
 void array_free(struct Array * array) {
 	if (array->allocate == NULL) { return; }
-	array->allocate(array->data, 0);
+	realloc_aligned(array->allocate, array->context, array->data, 0, array->alignment);
 	cbuffer_clear(CBMP_(array));
 }
 
@@ -29,7 +29,7 @@ void array_resize(struct Array * array, uint32_t capacity) {
 	if (array->allocate == NULL) {
 		array->allocate = DEFAULT_REALLOCATOR;
 	}
-	void * data = array->allocate(array->data, capacity * array->value_size);
+	void * data = realloc_aligned(array->allocate, array->context, array->data, capacity * array->value_size, array->alignment);
 	if (data == NULL) { return; }
 	array->capacity = capacity;
 	array->count = min_u32(array->count, capacity);
@@ -97,6 +97,19 @@ void array_insert_many(struct Array * array, uint32_t index, uint32_t count, voi
 	array->count += count;
 }
 
+void array_remove_many(struct Array * array, uint32_t index, uint32_t count) {
+	if (index + count > array->count) {
+		ERR("out of bounds");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return;
+	}
+	//
+	size_t const size = array->value_size * count;
+	uint8_t * at  = array_at_unsafe(array, index);
+	uint8_t * end = array_at_unsafe(array, array->count);
+	common_memmove(at, at + size, (size_t)(end - at) - size);
+	array->count -= count;
+}
+
 void * array_pop(struct Array * array, uint32_t count) {
 	if (array->count < count) {
 		ERR("out of bounds");
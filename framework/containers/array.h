@@ -10,8 +10,10 @@ struct Array_Iterator {
 
 struct Array {
 	Allocator * allocate;
+	struct Allocator_Context * context; // overrides `allocate`, if set
 	uint32_t value_size;
 	uint32_t capacity, count;
+	uint32_t alignment; // of `data`, see `realloc_aligned`; `0` is as the allocator's
 	void * data;
 };
 
@@ -28,6 +30,7 @@ void array_remove_if(struct Array * array, Predicate * predicate);
 void array_push_many(struct Array * array, uint32_t count, void const * value);
 void array_set_many(struct Array * array, uint32_t index, uint32_t count, void const * value);
 void array_insert_many(struct Array * array, uint32_t index, uint32_t count, void const * value);
+void array_remove_many(struct Array * array, uint32_t index, uint32_t count);
 
 void * array_pop(struct Array * array, uint32_t count);
 void * array_peek(struct Array const * array, uint32_t depth);
@@ -0,0 +1,42 @@
+// @note: no include guard; generates typed functions over `struct Array`
+// - `ARRAY_TYPED_NAME`  - functions are prefixed with `array_<name>_`
+// - `ARRAY_TYPED_VALUE` - a type of `value_size` bytes
+// @note: the storage is shared, so generic functions work for the same `struct Array`;
+//        it's a unity build, thus shared instances go into "typed.h"
+
+#include "framework/formatter.h"
+#include "array.h"
+
+#if !defined(ARRAY_TYPED_NAME) || !defined(ARRAY_TYPED_VALUE)
+	#error "define ARRAY_TYPED_NAME and ARRAY_TYPED_VALUE"
+#endif
+
+#define ARRAY_TYPED_FN(name) CAT_MCR(CAT_MCR(array_, ARRAY_TYPED_NAME), CAT_MCR(_, name))
+
+inline static struct Array ARRAY_TYPED_FN(init)(void) {
+	return array_init(sizeof(ARRAY_TYPED_VALUE));
+}
+
+inline static ARRAY_TYPED_VALUE * ARRAY_TYPED_FN(at_unsafe)(struct Array const * array, uint32_t index) {
+	return (ARRAY_TYPED_VALUE *)array->data + index;
+}
+
+inline static ARRAY_TYPED_VALUE * ARRAY_TYPED_FN(at)(struct Array const * array, uint32_t index) {
+	if (index >= array->count) {
+		ERR("out of bounds");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL;
+	}
+	return ARRAY_TYPED_FN(at_unsafe)(array, index);
+}
+
+inline static void ARRAY_TYPED_FN(push)(struct Array * array, ARRAY_TYPED_VALUE value) {
+	if (array->count >= array->capacity) {
+		array_ensure(array, array->count + 1);
+	}
+	((ARRAY_TYPED_VALUE *)array->data)[array->count++] = value;
+}
+
+#undef ARRAY_TYPED_FN
+
+#undef ARRAY_TYPED_NAME
+#undef ARRAY_TYPED_VALUE
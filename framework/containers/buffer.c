@@ -14,7 +14,7 @@ struct Buffer buffer_init(void) {
 
 void buffer_free(struct Buffer * buffer) {
 	if (buffer->allocate == NULL) { return; }
-	buffer->allocate(buffer->data, 0);
+	realloc_aligned(buffer->allocate, buffer->context, buffer->data, 0, buffer->alignment);
 	cbuffer_clear(CBMP_(buffer));
 }
 
@@ -27,7 +27,7 @@ void buffer_resize(struct Buffer * buffer, size_t capacity) {
 	if (buffer->allocate == NULL) {
 		buffer->allocate = DEFAULT_REALLOCATOR;
 	}
-	void * data = buffer->allocate(buffer->data, capacity);
+	void * data = realloc_aligned(buffer->allocate, buffer->context, buffer->data, capacity, buffer->alignment);
 	if (data == NULL) { return; }
 	buffer->capacity = capacity;
 	buffer->size = min_size(buffer->size, capacity);
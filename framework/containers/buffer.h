@@ -5,7 +5,9 @@
 
 struct Buffer {
 	Allocator * allocate;
+	struct Allocator_Context * context; // overrides `allocate`, if set
 	size_t capacity, size;
+	uint32_t alignment; // of `data`, see `realloc_aligned`; `0` is as the allocator's
 	void * data;
 };
 
@@ -0,0 +1,291 @@
+#include "framework/maths.h"
+#include "framework/formatter.h"
+#include "framework/systems/memory.h"
+
+#include "internal/helpers.h"
+
+// @note: up to that many entries are found by scanning the `hashes`, without an `index`
+#define DICTIONARY_SCAN_COUNT (SMALLARRAY_INLINE_SIZE / sizeof(uint32_t))
+
+//
+#include "dictionary.h"
+
+struct Dictionary dictionary_init(Hasher * get_hash, uint32_t key_size, uint32_t value_size) {
+	return (struct Dictionary){
+		.get_hash = get_hash,
+		.hashes = smallarray_init(sizeof(uint32_t)),
+		.keys   = smallarray_init(key_size),
+		.values = array_init(value_size),
+	};
+}
+
+void dictionary_free(struct Dictionary * dictionary) {
+	if (dictionary->allocate == NULL) { return; }
+	smallarray_free(&dictionary->hashes);
+	smallarray_free(&dictionary->keys);
+	array_free(&dictionary->values);
+	realloc_context(dictionary->allocate, dictionary->context, dictionary->index, 0);
+	cbuffer_clear(CBMP_(dictionary));
+}
+
+void dictionary_clear(struct Dictionary * dictionary) {
+	smallarray_clear(&dictionary->hashes);
+	smallarray_clear(&dictionary->keys);
+	array_clear(&dictionary->values);
+	if (dictionary->index == NULL) { return; }
+	common_memset(dictionary->index, 0, sizeof(*dictionary->index) * dictionary->capacity);
+}
+
+static uint32_t dictionary_find_slot(struct Dictionary const * dictionary, void const * key, uint32_t hash);
+static uint32_t dictionary_find_free_slot(struct Dictionary const * dictionary, uint32_t hash);
+static uint32_t dictionary_find_entry(struct Dictionary const * dictionary, void const * key, uint32_t hash);
+void dictionary_ensure(struct Dictionary * dictionary, uint32_t capacity) {
+	if (dictionary->allocate == NULL) {
+		dictionary->allocate = DEFAULT_REALLOCATOR;
+	}
+
+	// @note: entries share the allocator
+	dictionary->hashes.allocate = dictionary->allocate;
+	dictionary->keys.allocate   = dictionary->allocate;
+	dictionary->values.allocate = dictionary->allocate;
+	dictionary->hashes.context = dictionary->context;
+	dictionary->keys.context   = dictionary->context;
+	dictionary->values.context = dictionary->context;
+
+	smallarray_ensure(&dictionary->hashes, capacity);
+	smallarray_ensure(&dictionary->keys,   capacity);
+	if (dictionary->values.value_size > 0) {
+		array_ensure(&dictionary->values, capacity);
+	}
+
+	if (dictionary->index == NULL && capacity <= DICTIONARY_SCAN_COUNT) { return; }
+	if (!growth_hash_check(dictionary->capacity, capacity)) { return; }
+
+	uint32_t index_capacity = dictionary->capacity;
+	while (growth_hash_check(index_capacity, capacity)) {
+		index_capacity = growth_hash_adjust(index_capacity, capacity);
+	}
+
+	// @note: keep the old index should the allocation fail
+	uint32_t * index = realloc_context(dictionary->allocate, dictionary->context, NULL, sizeof(*index) * index_capacity);
+	if (index == NULL) { return; }
+	realloc_context(dictionary->allocate, dictionary->context, dictionary->index, 0);
+
+	dictionary->index = index;
+	dictionary->capacity = index_capacity;
+	common_memset(dictionary->index, 0, sizeof(*dictionary->index) * index_capacity);
+
+	// @note: entries stay as they are, only the index is rebuilt
+	FOR_SMALLARRAY(&dictionary->hashes, it) {
+		uint32_t const * hash = it.value;
+		uint32_t const slot = dictionary_find_free_slot(dictionary, *hash);
+		dictionary->index[slot] = it.curr + 1;
+	}
+}
+
+void * dictionary_get(struct Dictionary const * dictionary, void const * key) {
+	if (key == NULL) {
+		ERR("key should be non-null");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL;
+	}
+
+	if (dictionary->hashes.count == 0) { return NULL; }
+	uint32_t const hash = dictionary->get_hash(key);
+	uint32_t const entry = dictionary_find_entry(dictionary, key, hash);
+	if (entry == INDEX_EMPTY) { return NULL; }
+	return array_at_unsafe(&dictionary->values, entry);
+}
+
+bool dictionary_set(struct Dictionary * dictionary, void const * key, void const * value) {
+	if (key == NULL) {
+		ERR("key should be non-null");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return false;
+	}
+
+	dictionary_ensure(dictionary, dictionary->hashes.count + 1);
+
+	uint32_t const hash = dictionary->get_hash(key);
+	uint32_t const slot = (dictionary->index != NULL)
+		? dictionary_find_slot(dictionary, key, hash)
+		: INDEX_EMPTY;
+	uint32_t const entry = (dictionary->index != NULL)
+		? dictionary->index[slot] - 1
+		: dictionary_find_entry(dictionary, key, hash);
+
+	if (entry != INDEX_EMPTY) {
+		common_memcpy(smallarray_at_unsafe(&dictionary->keys, entry), key, dictionary->keys.value_size);
+		if (dictionary->values.value_size > 0) {
+			array_set_many(&dictionary->values, entry, 1, value);
+		}
+		return false;
+	}
+
+	smallarray_push_many(&dictionary->hashes, 1, &hash);
+	smallarray_push_many(&dictionary->keys,   1, key);
+	if (dictionary->values.value_size > 0) {
+		array_push_many(&dictionary->values, 1, value);
+	}
+	if (dictionary->index != NULL) {
+		dictionary->index[slot] = dictionary->hashes.count;
+	}
+	return true;
+}
+
+static void dictionary_remove_slot(struct Dictionary * dictionary, uint32_t slot);
+static void dictionary_remove_entry(struct Dictionary * dictionary, uint32_t entry);
+bool dictionary_del(struct Dictionary * dictionary, void const * key) {
+	if (key == NULL) {
+		ERR("key should be non-null");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return false;
+	}
+
+	if (dictionary->hashes.count == 0) { return false; }
+	uint32_t const hash = dictionary->get_hash(key);
+
+	if (dictionary->index == NULL) {
+		uint32_t const entry = dictionary_find_entry(dictionary, key, hash);
+		if (entry == INDEX_EMPTY) { return false; }
+		dictionary_remove_entry(dictionary, entry);
+		return true;
+	}
+
+	uint32_t const slot = dictionary_find_slot(dictionary, key, hash);
+	if (dictionary->index[slot] == 0) { return false; }
+	dictionary_remove_slot(dictionary, slot);
+	return true;
+}
+
+uint32_t dictionary_get_count(struct Dictionary const * dictionary) {
+	return dictionary->hashes.count;
+}
+
+void * dictionary_get_key_at(struct Dictionary const * dictionary, uint32_t index) {
+	if (index >= dictionary->hashes.count) { REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL; }
+	return smallarray_at_unsafe(&dictionary->keys, index);
+}
+
+void * dictionary_get_val_at(struct Dictionary const * dictionary, uint32_t index) {
+	if (index >= dictionary->hashes.count) { REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL; }
+	return array_at_unsafe(&dictionary->values, index);
+}
+
+void dictionary_del_at(struct Dictionary * dictionary, uint32_t index) {
+	if (index >= dictionary->hashes.count) { REPORT_CALLSTACK(); DEBUG_BREAK(); return; }
+
+	if (dictionary->index == NULL) {
+		dictionary_remove_entry(dictionary, index);
+		return;
+	}
+
+	uint32_t const * hash = smallarray_at_unsafe(&dictionary->hashes, index);
+	for (uint32_t i = 0; i < dictionary->capacity; i++) {
+		uint32_t const slot = HASH_TABLE_WRAP(*hash + i, dictionary->capacity);
+		if (dictionary->index[slot] != index + 1) { continue; }
+		dictionary_remove_slot(dictionary, slot);
+		return;
+	}
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+}
+
+bool dictionary_iterate(struct Dictionary const * dictionary, struct Dictionary_Iterator * iterator) {
+	if (iterator->next >= dictionary->hashes.count) { return false; }
+	uint32_t const index = iterator->next++;
+	uint32_t const * hash = smallarray_at_unsafe(&dictionary->hashes, index);
+	iterator->curr = index;
+	iterator->hash  = *hash;
+	iterator->key   = smallarray_at_unsafe(&dictionary->keys, index);
+	iterator->value = array_at_unsafe(&dictionary->values, index);
+	return true;
+}
+
+//
+
+static uint32_t dictionary_find_slot(struct Dictionary const * dictionary, void const * key, uint32_t hash) {
+	// @note: linear probing; returns either the slot of the key, or the first empty one
+	for (uint32_t i = 0; i < dictionary->capacity; i++) {
+		uint32_t const slot = HASH_TABLE_WRAP(hash + i, dictionary->capacity);
+		uint32_t const entry = dictionary->index[slot];
+		if (entry == 0) { return slot; }
+
+		uint32_t const * entry_hash = smallarray_at_unsafe(&dictionary->hashes, entry - 1);
+		if (*entry_hash != hash) { continue; }
+
+		void const * entry_key = smallarray_at_unsafe(&dictionary->keys, entry - 1);
+		if (equals(entry_key, key, dictionary->keys.value_size)) { return slot; }
+	}
+	return INDEX_EMPTY;
+}
+
+static uint32_t dictionary_find_free_slot(struct Dictionary const * dictionary, uint32_t hash) {
+	for (uint32_t i = 0; i < dictionary->capacity; i++) {
+		uint32_t const slot = HASH_TABLE_WRAP(hash + i, dictionary->capacity);
+		if (dictionary->index[slot] == 0) { return slot; }
+	}
+	return INDEX_EMPTY;
+}
+
+static uint32_t dictionary_find_entry(struct Dictionary const * dictionary, void const * key, uint32_t hash) {
+	if (dictionary->index != NULL) {
+		uint32_t const slot = dictionary_find_slot(dictionary, key, hash);
+		return dictionary->index[slot] - 1;
+	}
+
+	// @note: no index yet, the entries are few
+	FOR_SMALLARRAY(&dictionary->hashes, it) {
+		uint32_t const * entry_hash = it.value;
+		if (*entry_hash != hash) { continue; }
+
+		void const * entry_key = smallarray_at_unsafe(&dictionary->keys, it.curr);
+		if (equals(entry_key, key, dictionary->keys.value_size)) { return it.curr; }
+	}
+	return INDEX_EMPTY;
+}
+
+static void dictionary_remove_entry(struct Dictionary * dictionary, uint32_t entry) {
+	// @note: keep the order, shifting subsequent entries down
+	uint32_t const count = dictionary->hashes.count;
+	uint32_t const tail = count - entry - 1;
+	if (tail > 0) {
+		uint8_t * hash = smallarray_at_unsafe(&dictionary->hashes, entry);
+		uint8_t * key  = smallarray_at_unsafe(&dictionary->keys,   entry);
+		common_memmove(hash, hash + dictionary->hashes.value_size, (size_t)dictionary->hashes.value_size * tail);
+		common_memmove(key,  key  + dictionary->keys.value_size,   (size_t)dictionary->keys.value_size   * tail);
+	}
+	smallarray_pop(&dictionary->hashes, 1);
+	smallarray_pop(&dictionary->keys,   1);
+	if (dictionary->values.value_size > 0) {
+		array_remove_many(&dictionary->values, entry, 1);
+	}
+
+	if (dictionary->index == NULL) { return; }
+	if (entry + 1 == count) { return; }
+	for (uint32_t i = 0; i < dictionary->capacity; i++) {
+		if (dictionary->index[i] > entry + 1) { dictionary->index[i]--; }
+	}
+}
+
+static void dictionary_remove_slot(struct Dictionary * dictionary, uint32_t slot) {
+	uint32_t const entry = dictionary->index[slot] - 1;
+
+	// @note: backward shift deletion, same as for `struct Hashmap`
+	uint32_t hole = slot;
+	for (uint32_t i = 1; i < dictionary->capacity; i++) {
+		uint32_t const next = HASH_TABLE_WRAP(slot + i, dictionary->capacity);
+		uint32_t const next_entry = dictionary->index[next];
+		if (next_entry == 0) { break; }
+
+		uint32_t const * next_hash = smallarray_at_unsafe(&dictionary->hashes, next_entry - 1);
+		uint32_t const home = HASH_TABLE_WRAP(*next_hash, dictionary->capacity);
+		uint32_t const home_distance = HASH_TABLE_WRAP(next + dictionary->capacity - home, dictionary->capacity);
+		uint32_t const hole_distance = HASH_TABLE_WRAP(next + dictionary->capacity - hole, dictionary->capacity);
+		if (home_distance < hole_distance) { continue; }
+
+		dictionary->index[hole] = next_entry;
+		hole = next;
+	}
+	dictionary->index[hole] = 0;
+
+	dictionary_remove_entry(dictionary, entry);
+}
+
+#undef DICTIONARY_SCAN_COUNT
@@ -0,0 +1,55 @@
+#if !defined(FRAMEWORK_CONTAINERS_dictionary)
+#define FRAMEWORK_CONTAINERS_dictionary
+
+#include "array.h"
+#include "smallarray.h"
+
+struct Dictionary_Iterator {
+	uint32_t curr, next;
+	uint32_t hash;
+	void const * key;
+	void * value;
+};
+
+// @note: entries are kept dense and in insertion order; `index` is
+// a power of two table of `entry + 1`, with `0` meaning an empty slot;
+// a few entries go without it, just scanning the inline `hashes`
+
+// @note: `value_size == 0` is a valid option
+// and effectively turns a DICTIONARY into an ordered SET
+struct Dictionary {
+	Allocator * allocate;
+	struct Allocator_Context * context; // overrides `allocate`, if set
+	Hasher * get_hash;
+	struct Smallarray hashes; // `uint32_t`
+	struct Smallarray keys;   // of key_size
+	struct Array values;      // of value_size
+	uint32_t capacity;
+	uint32_t * index;
+};
+
+struct Dictionary dictionary_init(Hasher * get_hash, uint32_t key_size, uint32_t value_size);
+void dictionary_free(struct Dictionary * dictionary);
+
+void dictionary_clear(struct Dictionary * dictionary);
+void dictionary_ensure(struct Dictionary * dictionary, uint32_t capacity);
+
+void * dictionary_get(struct Dictionary const * dictionary, void const * key);
+bool dictionary_set(struct Dictionary * dictionary, void const * key, void const * value);
+bool dictionary_del(struct Dictionary * dictionary, void const * key);
+
+uint32_t dictionary_get_count(struct Dictionary const * dictionary);
+void * dictionary_get_key_at(struct Dictionary const * dictionary, uint32_t index);
+void * dictionary_get_val_at(struct Dictionary const * dictionary, uint32_t index);
+
+// @note: keeps the order, thus costs O(count); avoid it while iterating
+void dictionary_del_at(struct Dictionary * dictionary, uint32_t index);
+
+bool dictionary_iterate(struct Dictionary const * dictionary, struct Dictionary_Iterator * iterator);
+
+#define FOR_DICTIONARY(data, it) for ( \
+	struct Dictionary_Iterator it = {0}; \
+	dictionary_iterate(data, &it); \
+) \
+
+#endif
@@ -1,3 +1,4 @@
+#include "framework/maths.h"
 #include "framework/formatter.h"
 #include "framework/systems/memory.h"
 
@@ -7,7 +8,29 @@
 //
 #include "hashmap.h"
 
+// @note: `HASHMAP_FLAG_PACKED` block is laid out as `marks`, `epochs`,
+//        then `slots` of interleaved hash, key and value
+
+static uint8_t * hashmap_get_slot_at_unsafe(struct Hashmap const * hashmap, uint32_t index) {
+	size_t const offset = hashmap->slot_size * index;
+	return hashmap->slots + offset;
+}
+
+static uint8_t * hashmap_get_mark_at_unsafe(struct Hashmap const * hashmap, uint32_t index) {
+	return hashmap->marks + index;
+}
+
+static uint32_t * hashmap_get_hash_at_unsafe(struct Hashmap const * hashmap, uint32_t index) {
+	if (hashmap->slots != NULL) {
+		return (uint32_t *)(void *)hashmap_get_slot_at_unsafe(hashmap, index);
+	}
+	return hashmap->hashes + index;
+}
+
 static void * hashmap_get_key_at_unsafe(struct Hashmap const * hashmap, uint32_t index) {
+	if (hashmap->slots != NULL) {
+		return hashmap_get_slot_at_unsafe(hashmap, index) + hashmap->key_offset;
+	}
 	size_t const offset = hashmap->key_size * index;
 	return (uint8_t *)hashmap->keys + offset;
 }
@@ -15,10 +38,100 @@ static void * hashmap_get_key_at_unsafe(struct Hashmap const * hashmap, uint32_t
 static void * hashmap_get_val_at_unsafe(struct Hashmap const * hashmap, uint32_t index) {
 	// @note: places that call it already do the check
 	// if (index >= hashmap->capacity) { return NULL; }
+	if (hashmap->slots != NULL) {
+		return hashmap_get_slot_at_unsafe(hashmap, index) + hashmap->value_offset;
+	}
 	size_t const offset = hashmap->value_size * index;
 	return (uint8_t *)hashmap->values + offset;
 }
 
+static uint8_t * hashmap_get_group_at_unsafe(struct Hashmap const * hashmap, uint32_t group) {
+	return hashmap->marks + group * HASH_GROUP_WIDTH;
+}
+
+static uint32_t * hashmap_get_epoch_at_unsafe(struct Hashmap const * hashmap, uint32_t group) {
+	if (hashmap->epochs == NULL) { return NULL; }
+	return hashmap->epochs + group;
+}
+
+static bool hashmap_is_full_at(struct Hashmap const * hashmap, uint32_t index) {
+	if (!hash_mark_is_full(*hashmap_get_mark_at_unsafe(hashmap, index))) { return false; }
+	uint32_t const * epoch = hashmap_get_epoch_at_unsafe(hashmap, index / HASH_GROUP_WIDTH);
+	return epoch == NULL || *epoch == hashmap->epoch;
+}
+
+static uint8_t const * hashmap_get_group_marks(struct Hashmap const * hashmap, uint32_t group) {
+	static uint8_t const c_empty[HASH_GROUP_WIDTH] = {
+		HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE,
+		HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE,
+		HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE,
+		HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE, HASH_MARK_NONE,
+	};
+	uint32_t const * epoch = hashmap_get_epoch_at_unsafe(hashmap, group);
+	if (epoch != NULL && *epoch != hashmap->epoch) { return c_empty; }
+	return hashmap_get_group_at_unsafe(hashmap, group);
+}
+
+static void hashmap_refresh_group(struct Hashmap * hashmap, uint32_t group) {
+	uint32_t * epoch = hashmap_get_epoch_at_unsafe(hashmap, group);
+	if (epoch == NULL || *epoch == hashmap->epoch) { return; }
+	*epoch = hashmap->epoch;
+	common_memset(hashmap_get_group_at_unsafe(hashmap, group), HASH_MARK_NONE, HASH_GROUP_WIDTH);
+}
+
+static void hashmap_reset_groups(struct Hashmap * hashmap) {
+	common_memset(hashmap->marks, HASH_MARK_NONE, sizeof(*hashmap->marks) * hashmap->capacity);
+	if (hashmap->epochs == NULL) { return; }
+	for (uint32_t i = 0; i < hashmap->capacity / HASH_GROUP_WIDTH; i++) {
+		hashmap->epochs[i] = hashmap->epoch;
+	}
+}
+
+inline static uint32_t hashmap_align(uint32_t value, uint32_t alignment) {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+static void hashmap_allocate_packed(struct Hashmap * hashmap, uint32_t capacity) {
+	// @note: assume sizes multiple of 8 need 8-byte alignment, and 4-byte at most otherwise
+	uint32_t const key_align   = (hashmap->key_size   % 8 == 0) ? 8 : 4;
+	uint32_t const value_align = (hashmap->value_size % 8 == 0) ? 8 : 4;
+	uint32_t const slot_align  = max_u32(key_align, value_align);
+	hashmap->key_offset   = hashmap_align(sizeof(uint32_t), key_align);
+	hashmap->value_offset = hashmap_align(hashmap->key_offset + hashmap->key_size, value_align);
+	hashmap->slot_size    = hashmap_align(hashmap->value_offset + hashmap->value_size, slot_align);
+
+	uint32_t const epochs_count = (hashmap->flags & HASHMAP_FLAG_EPOCH) ? capacity / HASH_GROUP_WIDTH : 0;
+	size_t const marks_size  = sizeof(uint8_t) * capacity;
+	size_t const epochs_size = sizeof(uint32_t) * epochs_count;
+	size_t const slots_offset = (marks_size + epochs_size + 7) / 8 * 8;
+	size_t const slots_size  = (size_t)hashmap->slot_size * capacity;
+
+	uint8_t * block = realloc_context(hashmap->allocate, hashmap->context, NULL, slots_offset + slots_size);
+	hashmap->marks  = block;
+	hashmap->epochs = (epochs_count > 0) ? (uint32_t *)(void *)(block + marks_size) : NULL;
+	hashmap->slots  = block + slots_offset;
+}
+
+static void hashmap_free_storage(struct Hashmap const * hashmap) {
+	if (hashmap->slots != NULL) {
+		// @note: a single block, starting with `marks`
+		realloc_context(hashmap->allocate, hashmap->context, hashmap->marks, 0);
+		return;
+	}
+	realloc_context(hashmap->allocate, hashmap->context, hashmap->hashes, 0);
+	realloc_context(hashmap->allocate, hashmap->context, hashmap->keys,   0);
+	realloc_context(hashmap->allocate, hashmap->context, hashmap->values, 0);
+	realloc_context(hashmap->allocate, hashmap->context, hashmap->marks,  0);
+	realloc_context(hashmap->allocate, hashmap->context, hashmap->epochs, 0);
+}
+
+static void hashmap_drop_seeds(struct Hashmap * hashmap) {
+	if (hashmap->seeds == NULL) { return; }
+	realloc_context(hashmap->allocate, hashmap->context, hashmap->seeds, 0);
+	hashmap->seeds = NULL;
+	hashmap->seeds_count = 0;
+}
+
 struct Hashmap hashmap_init(Hasher * get_hash, uint32_t key_size, uint32_t value_size) {
 	return (struct Hashmap){
 		.get_hash = get_hash,
@@ -29,22 +142,26 @@ struct Hashmap hashmap_init(Hasher * get_hash, uint32_t key_size, uint32_t value
 
 void hashmap_free(struct Hashmap * hashmap) {
 	if (hashmap->allocate == NULL) { return; }
-	hashmap->allocate(hashmap->hashes, 0);
-	hashmap->allocate(hashmap->keys,   0);
-	hashmap->allocate(hashmap->values, 0);
-	hashmap->allocate(hashmap->marks,  0);
+	hashmap_drop_seeds(hashmap);
+	hashmap_free_storage(hashmap);
 	cbuffer_clear(CBMP_(hashmap));
 }
 
 void hashmap_clear(struct Hashmap * hashmap) {
+	hashmap_drop_seeds(hashmap);
 	hashmap->count = 0;
-	cbuffer_clear((struct CBuffer_Mut){
-		.size = sizeof(*hashmap->marks) * hashmap->capacity,
-		.data = hashmap->marks,
-	});
+	if (hashmap->epochs != NULL) {
+		hashmap->epoch++;
+		if (hashmap->epoch != 0) { return; }
+		// @note: stamps are about to be reused, restart from scratch
+	}
+	hashmap_reset_groups(hashmap);
 }
 
 static uint32_t hashmap_find_key_index(struct Hashmap const * hashmap, void const * key, uint32_t hash);
+static uint32_t hashmap_find_frozen_index(struct Hashmap const * hashmap, void const * key, uint32_t hash);
+static uint32_t hashmap_find_free_index(struct Hashmap const * hashmap, uint32_t hash);
+static void hashmap_remove_at(struct Hashmap * hashmap, uint32_t index);
 void hashmap_ensure(struct Hashmap * hashmap, uint32_t capacity) {
 	if (!growth_hash_check(hashmap->capacity, capacity)) { return; }
 	if (hashmap->allocate == NULL) {
@@ -58,51 +175,54 @@ void hashmap_ensure(struct Hashmap * hashmap, uint32_t capacity) {
 		REPORT_CALLSTACK(); DEBUG_BREAK(); return;
 	}
 
-	uint32_t * hashes = hashmap->hashes;
-	uint8_t  * keys   = hashmap->keys;
-	uint8_t  * values = hashmap->values;
-	uint8_t  * marks  = hashmap->marks;
+	// @note: entries are re-placed anyway, a frozen state is of no use
+	hashmap_drop_seeds(hashmap);
 
-	hashmap->hashes = hashmap->allocate(NULL, sizeof(uint32_t) * capacity);
-	hashmap->keys   = hashmap->allocate(NULL, sizeof(uint8_t)  * capacity * hashmap->key_size);
-	hashmap->values = hashmap->allocate(NULL, sizeof(uint8_t)  * capacity * hashmap->value_size);
-	hashmap->marks  = hashmap->allocate(NULL, sizeof(uint8_t)  * capacity);
+	// @note: `prev` keeps the old storage, `hashmap->count` remains as is
+	struct Hashmap const prev = *hashmap;
+	hashmap->capacity = capacity;
 
-	cbuffer_clear((struct CBuffer_Mut){
-		.size = sizeof(*hashmap->marks) * capacity,
-		.data = hashmap->marks,
-	});
+	if (hashmap->flags & HASHMAP_FLAG_PACKED) {
+		hashmap_allocate_packed(hashmap, capacity);
+	}
+	else {
+		hashmap->hashes = realloc_context(hashmap->allocate, hashmap->context, NULL, sizeof(uint32_t) * capacity);
+		hashmap->keys   = realloc_context(hashmap->allocate, hashmap->context, NULL, sizeof(uint8_t)  * capacity * hashmap->key_size);
+		hashmap->values = realloc_context(hashmap->allocate, hashmap->context, NULL, sizeof(uint8_t)  * capacity * hashmap->value_size);
+		hashmap->marks  = realloc_context(hashmap->allocate, hashmap->context, NULL, sizeof(uint8_t)  * capacity);
+		if (hashmap->flags & HASHMAP_FLAG_EPOCH) {
+			hashmap->epochs = realloc_context(hashmap->allocate, hashmap->context, NULL, sizeof(uint32_t) * (capacity / HASH_GROUP_WIDTH));
+		}
+	}
 
-	// @note: `hashmap->count` remains as is
-	uint32_t const prev_capacity = hashmap->capacity;
-	hashmap->capacity = capacity;
+	hashmap_reset_groups(hashmap);
 
-	for (uint32_t i = 0; i < prev_capacity; i++) {
-		if (marks[i] != HASH_MARK_FULL) { continue; }
+	for (uint32_t i = 0; i < prev.capacity; i++) {
+		if (!hashmap_is_full_at(&prev, i)) { continue; }
 
-		void const * ht_key = keys + hashmap->key_size * i;
-		uint32_t const key_index = hashmap_find_key_index(hashmap, ht_key, hashes[i]);
+		// @note: keys are unique already, no need to compare them
+		uint32_t const hash = *hashmap_get_hash_at_unsafe(&prev, i);
+		uint32_t const key_index = hashmap_find_free_index(hashmap, hash);
 		// if (key_index == INDEX_EMPTY) { REPORT_CALLSTACK(); DEBUG_BREAK(); continue; }
 		// if (key_index >= capacity)    { REPORT_CALLSTACK(); DEBUG_BREAK(); continue; }
 
-		hashmap->hashes[key_index] = hashes[i];
+		*hashmap_get_hash_at_unsafe(hashmap, key_index) = hash;
 		common_memcpy(
 			hashmap_get_key_at_unsafe(hashmap, key_index),
-			ht_key,
+			hashmap_get_key_at_unsafe(&prev, i),
 			hashmap->key_size
 		);
 		common_memcpy(
 			hashmap_get_val_at_unsafe(hashmap, key_index),
-			values + hashmap->value_size * i,
+			hashmap_get_val_at_unsafe(&prev, i),
 			hashmap->value_size
 		);
-		hashmap->marks[key_index] = HASH_MARK_FULL;
+		*hashmap_get_mark_at_unsafe(hashmap, key_index) = *hashmap_get_mark_at_unsafe(&prev, i);
 	}
 
-	hashmap->allocate(hashes, 0);
-	hashmap->allocate(keys,   0);
-	hashmap->allocate(values, 0);
-	hashmap->allocate(marks,  0);
+	if (prev.capacity > 0) {
+		hashmap_free_storage(&prev);
+	}
 }
 
 void * hashmap_get(struct Hashmap const * hashmap, void const * key) {
@@ -113,56 +233,173 @@ void * hashmap_get(struct Hashmap const * hashmap, void const * key) {
 
 	if (hashmap->count == 0) { return NULL; }
 	uint32_t const hash = hashmap->get_hash(key);
+
+	if (hashmap->seeds != NULL) {
+		uint32_t const key_index = hashmap_find_frozen_index(hashmap, key, hash);
+		if (key_index == INDEX_EMPTY) { return NULL; }
+		return hashmap_get_val_at_unsafe(hashmap, key_index);
+	}
+
 	uint32_t const key_index = hashmap_find_key_index(hashmap, key, hash);
 	// if (key_index == INDEX_EMPTY) { return NULL; }
-	if (hashmap->marks[key_index] != HASH_MARK_FULL) { return NULL; }
+	if (!hashmap_is_full_at(hashmap, key_index)) { return NULL; }
 	return hashmap_get_val_at_unsafe(hashmap, key_index);
 }
 
-bool hashmap_set(struct Hashmap * hashmap, void const * key, void const * value) {
-	if (key == NULL) {
-		ERR("key should be non-null");
-		REPORT_CALLSTACK(); DEBUG_BREAK(); return false;
-	}
-
-	hashmap_ensure(hashmap, hashmap->count + 1);
-
-	uint32_t const hash = hashmap->get_hash(key);
-	uint32_t const key_index = hashmap_find_key_index(hashmap, key, hash);
-	// if (key_index == INDEX_EMPTY) { return false; }
-	uint8_t const mark = hashmap->marks[key_index];
-	bool const is_new = (mark != HASH_MARK_FULL);
+static bool hashmap_set_at(struct Hashmap * hashmap, uint32_t index, uint32_t hash, void const * key, void const * value) {
+	bool const is_new = !hashmap_is_full_at(hashmap, index);
 	if (is_new) { hashmap->count++; }
+	hashmap_refresh_group(hashmap, index / HASH_GROUP_WIDTH);
 
-	hashmap->hashes[key_index] = hash;
+	*hashmap_get_hash_at_unsafe(hashmap, index) = hash;
 	common_memcpy(
-		hashmap_get_key_at_unsafe(hashmap, key_index),
+		hashmap_get_key_at_unsafe(hashmap, index),
 		key,
 		hashmap->key_size
 	);
 	common_memcpy(
-		hashmap_get_val_at_unsafe(hashmap, key_index),
+		hashmap_get_val_at_unsafe(hashmap, index),
 		value,
 		hashmap->value_size
 	);
-	hashmap->marks[key_index] = HASH_MARK_FULL;
-	
+	*hashmap_get_mark_at_unsafe(hashmap, index) = hash_mark_fingerprint(hash);
+
 	return is_new;
 }
 
-bool hashmap_del(struct Hashmap * hashmap, void const * key) {
+bool hashmap_set(struct Hashmap * hashmap, void const * key, void const * value) {
 	if (key == NULL) {
 		ERR("key should be non-null");
 		REPORT_CALLSTACK(); DEBUG_BREAK(); return false;
 	}
 
-	if (hashmap->count == 0) { return false; }
 	uint32_t const hash = hashmap->get_hash(key);
+
+	if (hashmap->seeds != NULL) {
+		uint32_t const key_index = hashmap_find_frozen_index(hashmap, key, hash);
+		if (key_index != INDEX_EMPTY) { return hashmap_set_at(hashmap, key_index, hash, key, value); }
+		// @note: a new key, thaw
+		hashmap_rehash_in_place(hashmap);
+	}
+
+	hashmap_ensure(hashmap, hashmap->count + 1);
+
 	uint32_t const key_index = hashmap_find_key_index(hashmap, key, hash);
 	// if (key_index == INDEX_EMPTY) { return false; }
-	if (hashmap->marks[key_index] != HASH_MARK_FULL) { return false; }
-	hashmap->marks[key_index] = HASH_MARK_SKIP;
-	hashmap->count--;
+	return hashmap_set_at(hashmap, key_index, hash, key, value);
+}
+
+static void hashmap_prefetch(struct Hashmap const * hashmap, uint32_t hash) {
+	uint32_t const home = HASH_TABLE_WRAP(hash, hashmap->capacity);
+	hash_prefetch(hashmap_get_mark_at_unsafe(hashmap, home));
+	// @note: keys and values are touched only on a fingerprint match
+	hash_prefetch(hashmap_get_hash_at_unsafe(hashmap, home));
+}
+
+#define HASHMAP_BATCH 16
+
+void hashmap_get_many(struct Hashmap const * hashmap, uint32_t count, void const * keys, void ** values) {
+	if (keys == NULL) {
+		ERR("keys should be non-null");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return;
+	}
+
+	if (hashmap->count == 0) {
+		common_memset(values, 0, sizeof(*values) * count);
+		return;
+	}
+
+	uint8_t const * keys_at = keys;
+
+	if (hashmap->seeds != NULL) {
+		// @note: a single slot per key, nothing to overlap
+		for (uint32_t i = 0; i < count; i++) {
+			void const * key = keys_at + hashmap->key_size * i;
+			uint32_t const key_index = hashmap_find_frozen_index(hashmap, key, hashmap->get_hash(key));
+			values[i] = (key_index != INDEX_EMPTY)
+				? hashmap_get_val_at_unsafe(hashmap, key_index)
+				: NULL;
+		}
+		return;
+	}
+
+	uint32_t hashes[HASHMAP_BATCH];
+	for (uint32_t offset = 0; offset < count; offset += HASHMAP_BATCH) {
+		uint32_t const batch = min_u32(count - offset, HASHMAP_BATCH);
+
+		for (uint32_t i = 0; i < batch; i++) {
+			hashes[i] = hashmap->get_hash(keys_at + hashmap->key_size * (offset + i));
+			hashmap_prefetch(hashmap, hashes[i]);
+		}
+
+		for (uint32_t i = 0; i < batch; i++) {
+			void const * key = keys_at + hashmap->key_size * (offset + i);
+			uint32_t const key_index = hashmap_find_key_index(hashmap, key, hashes[i]);
+			values[offset + i] = hashmap_is_full_at(hashmap, key_index)
+				? hashmap_get_val_at_unsafe(hashmap, key_index)
+				: NULL;
+		}
+	}
+}
+
+void hashmap_set_many(struct Hashmap * hashmap, uint32_t count, void const * keys, void const * values) {
+	if (keys == NULL) {
+		ERR("keys should be non-null");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return;
+	}
+
+	uint8_t const * keys_at = keys;
+	uint8_t const * values_at = values;
+
+	if (hashmap->seeds != NULL) {
+		// @note: stays frozen as long as only existing keys are updated
+		for (uint32_t i = 0; i < count; i++) {
+			void const * key   = keys_at   + hashmap->key_size   * i;
+			void const * value = (values_at != NULL) ? values_at + hashmap->value_size * i : NULL;
+			hashmap_set(hashmap, key, value);
+		}
+		return;
+	}
+
+	// @note: might overshoot for existing keys, but won't grow midway
+	while (growth_hash_check(hashmap->capacity, hashmap->count + count)) {
+		hashmap_ensure(hashmap, hashmap->count + count);
+	}
+
+	uint32_t hashes[HASHMAP_BATCH];
+	for (uint32_t offset = 0; offset < count; offset += HASHMAP_BATCH) {
+		uint32_t const batch = min_u32(count - offset, HASHMAP_BATCH);
+
+		for (uint32_t i = 0; i < batch; i++) {
+			hashes[i] = hashmap->get_hash(keys_at + hashmap->key_size * (offset + i));
+			hashmap_prefetch(hashmap, hashes[i]);
+		}
+
+		for (uint32_t i = 0; i < batch; i++) {
+			void const * key   = keys_at   + hashmap->key_size   * (offset + i);
+			void const * value = (values_at != NULL) ? values_at + hashmap->value_size * (offset + i) : NULL;
+			uint32_t const key_index = hashmap_find_key_index(hashmap, key, hashes[i]);
+			hashmap_set_at(hashmap, key_index, hashes[i], key, value);
+		}
+	}
+}
+
+#undef HASHMAP_BATCH
+
+bool hashmap_del(struct Hashmap * hashmap, void const * key) {
+	if (key == NULL) {
+		ERR("key should be non-null");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return false;
+	}
+
+	if (hashmap->count == 0) { return false; }
+	uint32_t const hash = hashmap->get_hash(key);
+	uint32_t const key_index = (hashmap->seeds != NULL)
+		? hashmap_find_frozen_index(hashmap, key, hash)
+		: hashmap_find_key_index(hashmap, key, hash);
+	if (key_index == INDEX_EMPTY) { return false; }
+	if (!hashmap_is_full_at(hashmap, key_index)) { return false; }
+	hashmap_remove_at(hashmap, key_index);
 	return true;
 }
 
@@ -171,30 +408,43 @@ uint32_t hashmap_get_count(struct Hashmap const * hashmap) {
 }
 
 void * hashmap_get_key_at(struct Hashmap const * hashmap, uint32_t index) {
-	if (index >= hashmap->capacity)              { REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL; }
-	if (hashmap->marks[index] != HASH_MARK_FULL) { return NULL; }
+	if (index >= hashmap->capacity)          { REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL; }
+	if (!hashmap_is_full_at(hashmap, index)) { return NULL; }
 	return hashmap_get_key_at_unsafe(hashmap, index);
 }
 
 void * hashmap_get_val_at(struct Hashmap const * hashmap, uint32_t index) {
-	if (index >= hashmap->capacity)              { REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL; }
-	if (hashmap->marks[index] != HASH_MARK_FULL) { return NULL; }
+	if (index >= hashmap->capacity)          { REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL; }
+	if (!hashmap_is_full_at(hashmap, index)) { return NULL; }
 	return hashmap_get_val_at_unsafe(hashmap, index);
 }
 
 void hashmap_del_at(struct Hashmap * hashmap, uint32_t index) {
-	if (index >= hashmap->capacity)              { REPORT_CALLSTACK(); DEBUG_BREAK(); return; }
-	if (hashmap->marks[index] != HASH_MARK_FULL) { return; }
-	hashmap->marks[index] = HASH_MARK_SKIP;
-	hashmap->count--;
+	if (index >= hashmap->capacity)          { REPORT_CALLSTACK(); DEBUG_BREAK(); return; }
+	if (!hashmap_is_full_at(hashmap, index)) { return; }
+	hashmap_remove_at(hashmap, index);
 }
 
 bool hashmap_iterate(struct Hashmap const * hashmap, struct Hashmap_Iterator * iterator) {
+	// @note: walk backwards, starting right below an empty slot; that way
+	//        `hashmap_del_at` of the current entry only shifts already visited
+	//        ones into it, neither skipping nor repeating anything
+	if (hashmap->count == 0) { return false; }
+	if (iterator->next == 0) {
+		iterator->start = hashmap_find_free_index(hashmap, 0);
+	}
 	while (iterator->next < hashmap->capacity) {
-		uint32_t const index = iterator->next++;
-		if (hashmap->marks[index] != HASH_MARK_FULL) { continue; }
+		uint32_t const index = HASH_TABLE_WRAP(iterator->start + hashmap->capacity - 1 - iterator->next, hashmap->capacity);
+		// @note: skip the rest of a group at once if it's empty, stale ones included
+		uint8_t const * marks = hashmap_get_group_marks(hashmap, index / HASH_GROUP_WIDTH);
+		if (hash_group_match_free(marks) == HASH_GROUP_MASK) {
+			iterator->next += index % HASH_GROUP_WIDTH + 1;
+			continue;
+		}
+		iterator->next++;
+		if (!hashmap_is_full_at(hashmap, index)) { continue; }
 		iterator->curr = index;
-		iterator->hash  = hashmap->hashes[index];
+		iterator->hash  = *hashmap_get_hash_at_unsafe(hashmap, index);
 		iterator->key   = hashmap_get_key_at_unsafe(hashmap, index);
 		iterator->value = hashmap_get_val_at_unsafe(hashmap, index);
 		return true;
@@ -202,30 +452,323 @@ bool hashmap_iterate(struct Hashmap const * hashmap, struct Hashmap_Iterator * i
 	return false;
 }
 
+static void hashmap_swap_at(struct Hashmap * hashmap, uint32_t index1, uint32_t index2);
+void hashmap_rehash_in_place(struct Hashmap * hashmap) {
+	hashmap_drop_seeds(hashmap);
+
+	// @note: mark every entry as pending, then settle them one by one,
+	//        swapping with pending ones that occupy the target slot
+	for (uint32_t i = 0; i < hashmap->capacity / HASH_GROUP_WIDTH; i++) {
+		hashmap_refresh_group(hashmap, i);
+	}
+
+	for (uint32_t i = 0; i < hashmap->capacity; i++) {
+		if (!hash_mark_is_full(*hashmap_get_mark_at_unsafe(hashmap, i))) { continue; }
+		*hashmap_get_hash_at_unsafe(hashmap, i) = hashmap->get_hash(hashmap_get_key_at_unsafe(hashmap, i));
+		*hashmap_get_mark_at_unsafe(hashmap, i) = HASH_MARK_SKIP;
+	}
+
+	for (uint32_t i = 0; i < hashmap->capacity; i++) {
+		while (*hashmap_get_mark_at_unsafe(hashmap, i) == HASH_MARK_SKIP) {
+			uint32_t const hash = *hashmap_get_hash_at_unsafe(hashmap, i);
+			uint32_t const key_index = hashmap_find_free_index(hashmap, hash);
+
+			if (key_index != i) {
+				hashmap_swap_at(hashmap, i, key_index);
+				*hashmap_get_mark_at_unsafe(hashmap, i) = *hashmap_get_mark_at_unsafe(hashmap, key_index);
+			}
+			*hashmap_get_mark_at_unsafe(hashmap, key_index) = hash_mark_fingerprint(hash);
+		}
+	}
+}
+
+static bool hashmap_freeze_bucket(uint32_t * seed, uint32_t const * hashes, uint32_t size, uint32_t count, uint8_t * taken) {
+	// @note: keys that share a hash can't be told apart by any seed
+	for (uint32_t i = 0; i < size; i++) {
+		for (uint32_t j = 0; j < i; j++) {
+			if (hashes[i] == hashes[j]) { return false; }
+		}
+	}
+
+	// @note: the last buckets have a few free slots left to hit
+	uint32_t const attempts = max_u32(count, 1024) * 64;
+	for (uint32_t attempt = 0; attempt < attempts; attempt++) {
+		uint32_t placed = 0;
+		for (; placed < size; placed++) {
+			uint32_t const index = hash_frozen_index(hashes[placed], attempt, count);
+			if (taken[index]) { break; }
+			taken[index] = true;
+		}
+		if (placed == size) { *seed = attempt; return true; }
+
+		for (uint32_t i = 0; i < placed; i++) {
+			taken[hash_frozen_index(hashes[i], attempt, count)] = false;
+		}
+	}
+
+	return false;
+}
+
+bool hashmap_freeze(struct Hashmap * hashmap) {
+	uint32_t const count = hashmap->count;
+	if (count == 0) { hashmap_drop_seeds(hashmap); return true; }
+
+	// @note: current seeds, if any, stay until the new ones are found;
+	//        placement only reads hashes, and entries move afterwards
+
+	// @note: CHD, "hash, displace and compress"; place buckets by seeds,
+	//        the largest ones go first, while there is still room
+	uint32_t seeds_count = 1;
+	while (seeds_count * 2 < count) { seeds_count *= 2; }
+
+	uint32_t * seeds = realloc_context(hashmap->allocate, hashmap->context, NULL, sizeof(*seeds) * seeds_count);
+	common_memset(seeds, 0, sizeof(*seeds) * seeds_count);
+
+	// @note: scratch is `offsets` of buckets, their `hashes`, then `taken` slots
+	size_t const offsets_size = sizeof(uint32_t) * (seeds_count + 1);
+	size_t const hashes_size  = sizeof(uint32_t) * count;
+	uint8_t * scratch = realloc_context(hashmap->allocate, hashmap->context, NULL, offsets_size + hashes_size + sizeof(uint8_t) * count);
+	uint32_t * offsets = (uint32_t *)(void *)scratch;
+	uint32_t * hashes  = (uint32_t *)(void *)(scratch + offsets_size);
+	uint8_t  * taken   = scratch + offsets_size + hashes_size;
+	common_memset(offsets, 0, offsets_size);
+	common_memset(taken,   0, sizeof(uint8_t) * count);
+
+	// @note: counting sort of hashes by buckets
+	for (uint32_t i = 0; i < hashmap->capacity; i++) {
+		if (!hashmap_is_full_at(hashmap, i)) { continue; }
+		uint32_t const hash = *hashmap_get_hash_at_unsafe(hashmap, i);
+		offsets[hash_frozen_bucket(hash, seeds_count)]++;
+	}
+
+	uint32_t bucket_size_max = 0;
+	for (uint32_t i = 0, start = 0; i <= seeds_count; i++) {
+		uint32_t const size = offsets[i];
+		bucket_size_max = max_u32(bucket_size_max, size);
+		offsets[i] = start;
+		start += size;
+	}
+
+	for (uint32_t i = 0; i < hashmap->capacity; i++) {
+		if (!hashmap_is_full_at(hashmap, i)) { continue; }
+		uint32_t const hash = *hashmap_get_hash_at_unsafe(hashmap, i);
+		hashes[offsets[hash_frozen_bucket(hash, seeds_count)]++] = hash;
+	}
+
+	// @note: offsets went one bucket ahead
+	for (uint32_t i = seeds_count; i > 0; i--) { offsets[i] = offsets[i - 1]; }
+	offsets[0] = 0;
+
+	bool success = true;
+	for (uint32_t size = bucket_size_max; size > 0 && success; size--) {
+		for (uint32_t i = 0; i < seeds_count && success; i++) {
+			if (offsets[i + 1] - offsets[i] != size) { continue; }
+			success = hashmap_freeze_bucket(seeds + i, hashes + offsets[i], size, count, taken);
+		}
+	}
+
+	realloc_context(hashmap->allocate, hashmap->context, scratch, 0);
+	if (!success) {
+		realloc_context(hashmap->allocate, hashmap->context, seeds, 0);
+		return false;
+	}
+
+	hashmap_drop_seeds(hashmap);
+	hashmap->seeds = seeds;
+	hashmap->seeds_count = seeds_count;
+
+	// @note: same as `hashmap_rehash_in_place`, just with a different target slot
+	for (uint32_t i = 0; i < hashmap->capacity / HASH_GROUP_WIDTH; i++) {
+		hashmap_refresh_group(hashmap, i);
+	}
+
+	for (uint32_t i = 0; i < hashmap->capacity; i++) {
+		if (!hash_mark_is_full(*hashmap_get_mark_at_unsafe(hashmap, i))) { continue; }
+		*hashmap_get_mark_at_unsafe(hashmap, i) = HASH_MARK_SKIP;
+	}
+
+	for (uint32_t i = 0; i < hashmap->capacity; i++) {
+		while (*hashmap_get_mark_at_unsafe(hashmap, i) == HASH_MARK_SKIP) {
+			uint32_t const hash = *hashmap_get_hash_at_unsafe(hashmap, i);
+			uint32_t const seed = seeds[hash_frozen_bucket(hash, seeds_count)];
+			uint32_t const key_index = hash_frozen_index(hash, seed, count);
+
+			if (key_index != i) {
+				hashmap_swap_at(hashmap, i, key_index);
+				*hashmap_get_mark_at_unsafe(hashmap, i) = *hashmap_get_mark_at_unsafe(hashmap, key_index);
+			}
+			*hashmap_get_mark_at_unsafe(hashmap, key_index) = hash_mark_fingerprint(hash);
+		}
+	}
+
+	return true;
+}
+
+struct Hashmap_Stats hashmap_get_stats(struct Hashmap const * hashmap) {
+	struct Hashmap_Stats stats = {
+		.capacity = hashmap->capacity,
+		.count = hashmap->count,
+	};
+
+	uint32_t cluster = 0;
+	for (uint32_t i = 0; i < hashmap->capacity; i++) {
+		if (!hashmap_is_full_at(hashmap, i)) { cluster = 0; continue; }
+		cluster++;
+
+		uint32_t const home = HASH_TABLE_WRAP(*hashmap_get_hash_at_unsafe(hashmap, i), hashmap->capacity);
+		uint32_t const probe = HASH_TABLE_WRAP(i + hashmap->capacity - home, hashmap->capacity);
+		stats.probe_total += probe;
+		stats.probe_max = max_u32(stats.probe_max, probe);
+		stats.cluster_max = max_u32(stats.cluster_max, cluster);
+	}
+
+	// @note: account for a cluster that wraps around the end
+	for (uint32_t i = 0; cluster > 0 && i < hashmap->capacity; i++) {
+		if (!hashmap_is_full_at(hashmap, i)) { break; }
+		cluster++;
+		stats.cluster_max = max_u32(stats.cluster_max, cluster);
+	}
+
+	return stats;
+}
+
 //
 
 static uint32_t hashmap_find_key_index(struct Hashmap const * hashmap, void const * key, uint32_t hash) {
-	uint32_t empty = INDEX_EMPTY;
+	// @note: linear probing, checking a whole aligned group of marks at once;
+	//        the home group is masked to start from the home slot, and is
+	//        revisited at the very end for the slots that precede it
+	uint8_t const fingerprint = hash_mark_fingerprint(hash);
+	uint32_t const home = HASH_TABLE_WRAP(hash, hashmap->capacity);
+	uint32_t const home_mask = (HASH_GROUP_MASK << (home % HASH_GROUP_WIDTH)) & HASH_GROUP_MASK;
+	uint32_t const groups_count = hashmap->capacity / HASH_GROUP_WIDTH;
+	uint32_t const groups_offset = home / HASH_GROUP_WIDTH;
+
+	// @note: a direct hit is the most common case; its loads don't depend on the group scan
+	if (*hashmap_get_mark_at_unsafe(hashmap, home) == fingerprint && *hashmap_get_hash_at_unsafe(hashmap, home) == hash && hashmap_is_full_at(hashmap, home)) {
+		void const * ht_key = hashmap_get_key_at_unsafe(hashmap, home);
+		if (equals(ht_key, key, hashmap->key_size)) { return home; }
+	}
 
-	uint32_t const offset = HASH_TABLE_WRAP(hash, hashmap->capacity);
-	for (uint32_t i = 0; i < hashmap->capacity; i++) {
-		uint32_t const index = HASH_TABLE_WRAP(i + offset, hashmap->capacity);
+	for (uint32_t i = 0; i <= groups_count; i++) {
+		uint32_t const group = HASH_TABLE_WRAP(i + groups_offset, groups_count);
+		uint32_t const window = (i == 0) ? home_mask
+			: (i == groups_count) ? (~home_mask & HASH_GROUP_MASK)
+			: HASH_GROUP_MASK;
 
-		uint8_t const mark = hashmap->marks[index];
-		if (mark == HASH_MARK_SKIP) {
-			if (empty == INDEX_EMPTY) { empty = index; }
-			continue;
+		uint32_t const offset = group * HASH_GROUP_WIDTH;
+		uint8_t const * marks = hashmap_get_group_marks(hashmap, group);
+
+		for (uint32_t match = hash_group_match(marks, fingerprint) & window; match != 0; match &= match - 1) {
+			uint32_t const index = offset + hash_group_first(match);
+			if (*hashmap_get_hash_at_unsafe(hashmap, index) != hash) { continue; }
+
+			void const * ht_key = hashmap_get_key_at_unsafe(hashmap, index);
+			if (equals(ht_key, key, hashmap->key_size)) { return index; }
 		}
-		if (mark == HASH_MARK_NONE) {
-			if (empty == INDEX_EMPTY) { empty = index; }
-			break;
+
+		uint32_t const available = hash_group_match_free(marks) & window;
+		if (available != 0) { return offset + hash_group_first(available); }
+	}
+
+	return INDEX_EMPTY;
+}
+
+static uint32_t hashmap_find_frozen_index(struct Hashmap const * hashmap, void const * key, uint32_t hash) {
+	// @note: a single slot to check, it holds either the key or some other one
+	uint32_t const seed = hashmap->seeds[hash_frozen_bucket(hash, hashmap->seeds_count)];
+	uint32_t const index = hash_frozen_index(hash, seed, hashmap->count);
+	if (*hashmap_get_hash_at_unsafe(hashmap, index) != hash) { return INDEX_EMPTY; }
+
+	void const * ht_key = hashmap_get_key_at_unsafe(hashmap, index);
+	if (!equals(ht_key, key, hashmap->key_size)) { return INDEX_EMPTY; }
+	return index;
+}
+
+static uint32_t hashmap_find_free_index(struct Hashmap const * hashmap, uint32_t hash) {
+	uint32_t const home = HASH_TABLE_WRAP(hash, hashmap->capacity);
+	uint32_t const home_mask = (HASH_GROUP_MASK << (home % HASH_GROUP_WIDTH)) & HASH_GROUP_MASK;
+	uint32_t const groups_count = hashmap->capacity / HASH_GROUP_WIDTH;
+	uint32_t const groups_offset = home / HASH_GROUP_WIDTH;
+
+	for (uint32_t i = 0; i <= groups_count; i++) {
+		uint32_t const group = HASH_TABLE_WRAP(i + groups_offset, groups_count);
+		uint32_t const window = (i == 0) ? home_mask
+			: (i == groups_count) ? (~home_mask & HASH_GROUP_MASK)
+			: HASH_GROUP_MASK;
+
+		uint32_t const offset = group * HASH_GROUP_WIDTH;
+		uint32_t const available = hash_group_match_free(hashmap_get_group_marks(hashmap, group)) & window;
+		if (available != 0) { return offset + hash_group_first(available); }
+	}
+
+	return INDEX_EMPTY;
+}
+
+static void hashmap_remove_at(struct Hashmap * hashmap, uint32_t index) {
+	if (hashmap->seeds != NULL) {
+		// @note: frozen entries are dense, so fill the hole with the last one, then thaw
+		uint32_t const last = hashmap->count - 1;
+		if (index != last) {
+			hashmap_swap_at(hashmap, index, last);
 		}
+		*hashmap_get_mark_at_unsafe(hashmap, last) = HASH_MARK_NONE;
+		hashmap->count--;
+		hashmap_rehash_in_place(hashmap);
+		return;
+	}
+
+	// @note: backward shift deletion; pull subsequent entries of the chain
+	//        into the hole, unless that would put them before their home slot
+	uint32_t hole = index;
+	for (uint32_t i = 1; i < hashmap->capacity; i++) {
+		uint32_t const next = HASH_TABLE_WRAP(index + i, hashmap->capacity);
+		if (!hashmap_is_full_at(hashmap, next)) { break; }
+
+		uint32_t const home = HASH_TABLE_WRAP(*hashmap_get_hash_at_unsafe(hashmap, next), hashmap->capacity);
+		uint32_t const home_distance = HASH_TABLE_WRAP(next + hashmap->capacity - home, hashmap->capacity);
+		uint32_t const hole_distance = HASH_TABLE_WRAP(next + hashmap->capacity - hole, hashmap->capacity);
+		if (home_distance < hole_distance) { continue; }
+
+		*hashmap_get_hash_at_unsafe(hashmap, hole) = *hashmap_get_hash_at_unsafe(hashmap, next);
+		common_memcpy(
+			hashmap_get_key_at_unsafe(hashmap, hole),
+			hashmap_get_key_at_unsafe(hashmap, next),
+			hashmap->key_size
+		);
+		common_memcpy(
+			hashmap_get_val_at_unsafe(hashmap, hole),
+			hashmap_get_val_at_unsafe(hashmap, next),
+			hashmap->value_size
+		);
+		*hashmap_get_mark_at_unsafe(hashmap, hole) = *hashmap_get_mark_at_unsafe(hashmap, next);
+		hole = next;
+	}
 
-		if (hashmap->hashes[index] != hash) { continue; }
+	*hashmap_get_mark_at_unsafe(hashmap, hole) = HASH_MARK_NONE;
+	hashmap->count--;
+}
 
-		void const * ht_key = hashmap_get_key_at_unsafe(hashmap, index);
-		if (equals(ht_key, key, hashmap->key_size)) { return index; }
+static void hashmap_swap_bytes(uint8_t * v1, uint8_t * v2, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		uint8_t const temp = v1[i];
+		v1[i] = v2[i];
+		v2[i] = temp;
 	}
+}
 
-	return empty;
+static void hashmap_swap_at(struct Hashmap * hashmap, uint32_t index1, uint32_t index2) {
+	uint32_t const hash = *hashmap_get_hash_at_unsafe(hashmap, index1);
+	*hashmap_get_hash_at_unsafe(hashmap, index1) = *hashmap_get_hash_at_unsafe(hashmap, index2);
+	*hashmap_get_hash_at_unsafe(hashmap, index2) = hash;
+	hashmap_swap_bytes(
+		hashmap_get_key_at_unsafe(hashmap, index1),
+		hashmap_get_key_at_unsafe(hashmap, index2),
+		hashmap->key_size
+	);
+	hashmap_swap_bytes(
+		hashmap_get_val_at_unsafe(hashmap, index1),
+		hashmap_get_val_at_unsafe(hashmap, index2),
+		hashmap->value_size
+	);
 }
@@ -4,7 +4,7 @@
 #include "framework/common.h"
 
 struct Hashmap_Iterator {
-	uint32_t curr, next;
+	uint32_t curr, next, start;
 	uint32_t hash;
 	void const * key;
 	void * value;
@@ -12,15 +12,45 @@ struct Hashmap_Iterator {
 
 // @note: `value_size == 0` is a valid option
 // and effectively turns a hash MAP into a hash SET
+
+// @note: flags are expected to be set before the first use
+enum Hashmap_Flag {
+	HASHMAP_FLAG_NONE   = 0,
+	HASHMAP_FLAG_EPOCH  = (1 << 0), // O(1) `hashmap_clear`, at a cost of an epoch per group
+	HASHMAP_FLAG_PACKED = (1 << 1), // a single block, with interleaved hash-key-value slots
+};
+
+// @note: `marks` are either empty or a 7-bit fingerprint of the hash;
+// lookups compare a whole group of them at once, see `HASH_GROUP_WIDTH`;
+// deletion shifts the chain back, thus there are no tombstones
+
+// @note: with `HASHMAP_FLAG_EPOCH` a group of `marks` counts as empty
+// unless it is stamped with the current `epoch`; clearing just bumps it
+
+// @note: with `HASHMAP_FLAG_PACKED` a lookup touches a group of `marks`
+// and then a slot, where the hash, the key and the value sit together
+
+// @note: a frozen one keeps entries densely at `[0 .. count)`, placed by a minimal
+// perfect hash: a bucket of the hash picks a `seed`, the seeded hash picks the slot
 struct Hashmap {
 	Allocator * allocate;
+	struct Allocator_Context * context; // overrides `allocate`, if set
 	Hasher * get_hash;
+	enum Hashmap_Flag flags;
 	uint32_t key_size, value_size;
 	uint32_t capacity, count;
 	uint32_t * hashes;
 	void * keys;
 	void * values;
 	uint8_t * marks;
+	uint32_t epoch;
+	uint32_t * epochs;
+	// @note: `HASHMAP_FLAG_PACKED` storage, `hashes`, `keys` and `values` stay unused
+	uint8_t * slots;
+	uint32_t slot_size, key_offset, value_offset;
+	// @note: `hashmap_freeze` storage, a seed per bucket
+	uint32_t seeds_count;
+	uint32_t * seeds;
 };
 
 struct Hashmap hashmap_init(Hasher * get_hash, uint32_t key_size, uint32_t value_size);
@@ -33,6 +63,11 @@ void * hashmap_get(struct Hashmap const * hashmap, void const * key);
 bool hashmap_set(struct Hashmap * hashmap, void const * key, void const * value);
 bool hashmap_del(struct Hashmap * hashmap, void const * key);
 
+// @note: `keys` and `values` are tightly packed arrays of `count` elements;
+// hashing and prefetching go ahead of probing, so cache misses overlap
+void hashmap_get_many(struct Hashmap const * hashmap, uint32_t count, void const * keys, void ** values);
+void hashmap_set_many(struct Hashmap * hashmap, uint32_t count, void const * keys, void const * values);
+
 
 uint32_t hashmap_get_count(struct Hashmap const * hashmap);
 void * hashmap_get_key_at(struct Hashmap const * hashmap, uint32_t index);
@@ -41,6 +76,24 @@ void hashmap_del_at(struct Hashmap * hashmap, uint32_t index);
 
 bool hashmap_iterate(struct Hashmap const * hashmap, struct Hashmap_Iterator * iterator);
 
+// @note: re-places all entries from scratch, without allocations;
+// it also rehashes the keys, so `get_hash` might be changed beforehand
+void hashmap_rehash_in_place(struct Hashmap * hashmap);
+
+// @note: builds a minimal perfect hash (CHD) over the current keys, so lookups
+// cost a single slot, found or not; updating values of existing keys keeps it
+// frozen, adding or deleting ones thaws it back; returns `false` if two keys
+// share a hash, leaving the hashmap as it was
+bool hashmap_freeze(struct Hashmap * hashmap);
+
+struct Hashmap_Stats {
+	uint32_t capacity, count;
+	uint32_t probe_max, probe_total; // distance from the home slot
+	uint32_t cluster_max;            // run of consecutive full slots
+};
+
+struct Hashmap_Stats hashmap_get_stats(struct Hashmap const * hashmap);
+
 #define FOR_HASHMAP(data, it) for ( \
 	struct Hashmap_Iterator it = {0}; \
 	hashmap_iterate(data, &it); \
@@ -0,0 +1,121 @@
+// @note: no include guard; generates typed functions over `struct Hashmap`
+// - `HASHMAP_TYPED_NAME`   - functions are prefixed with `hashmap_<name>_`
+// - `HASHMAP_TYPED_KEY`    - a type of `key_size` bytes
+// - `HASHMAP_TYPED_VALUE`  - a type of `value_size` bytes
+// - `HASHMAP_TYPED_HASHER` - a `HASHER` function, the same as the hashmap `get_hash`
+// - `HASHMAP_TYPED_EQUALS(key1, key2)` - compares two keys pointers
+// @note: the storage is shared, so generic functions work for the same `struct Hashmap`;
+//        lookups are typed and inlined, while insertions of new keys fall back to the
+//        generic `hashmap_set`; it's a unity build, thus shared instances go into "typed.h"
+
+#include "hashmap.h"
+#include "internal/helpers.h"
+
+#if !defined(HASHMAP_TYPED_NAME) || !defined(HASHMAP_TYPED_KEY) || !defined(HASHMAP_TYPED_VALUE)
+	#error "define HASHMAP_TYPED_NAME, HASHMAP_TYPED_KEY and HASHMAP_TYPED_VALUE"
+#endif
+
+#if !defined(HASHMAP_TYPED_HASHER) || !defined(HASHMAP_TYPED_EQUALS)
+	#error "define HASHMAP_TYPED_HASHER and HASHMAP_TYPED_EQUALS"
+#endif
+
+#define HASHMAP_TYPED_FN(name) CAT_MCR(CAT_MCR(hashmap_, HASHMAP_TYPED_NAME), CAT_MCR(_, name))
+
+inline static struct Hashmap HASHMAP_TYPED_FN(init)(void) {
+	return hashmap_init(HASHMAP_TYPED_HASHER, sizeof(HASHMAP_TYPED_KEY), sizeof(HASHMAP_TYPED_VALUE));
+}
+
+inline static uint32_t * HASHMAP_TYPED_FN(hash_at_unsafe)(struct Hashmap const * hashmap, uint32_t index) {
+	if (hashmap->slots != NULL) {
+		return (uint32_t *)(void *)(hashmap->slots + (size_t)hashmap->slot_size * index);
+	}
+	return hashmap->hashes + index;
+}
+
+inline static HASHMAP_TYPED_KEY * HASHMAP_TYPED_FN(key_at_unsafe)(struct Hashmap const * hashmap, uint32_t index) {
+	if (hashmap->slots != NULL) {
+		return (HASHMAP_TYPED_KEY *)(void *)(hashmap->slots + (size_t)hashmap->slot_size * index + hashmap->key_offset);
+	}
+	return (HASHMAP_TYPED_KEY *)hashmap->keys + index;
+}
+
+inline static HASHMAP_TYPED_VALUE * HASHMAP_TYPED_FN(val_at_unsafe)(struct Hashmap const * hashmap, uint32_t index) {
+	if (hashmap->slots != NULL) {
+		return (HASHMAP_TYPED_VALUE *)(void *)(hashmap->slots + (size_t)hashmap->slot_size * index + hashmap->value_offset);
+	}
+	return (HASHMAP_TYPED_VALUE *)hashmap->values + index;
+}
+
+inline static bool HASHMAP_TYPED_FN(is_stale)(struct Hashmap const * hashmap, uint32_t group) {
+	return hashmap->epochs != NULL && hashmap->epochs[group] != hashmap->epoch;
+}
+
+inline static bool HASHMAP_TYPED_FN(is_key_at)(struct Hashmap const * hashmap, uint32_t index, HASHMAP_TYPED_KEY const * key, uint32_t hash) {
+	if (*HASHMAP_TYPED_FN(hash_at_unsafe)(hashmap, index) != hash) { return false; }
+	HASHMAP_TYPED_KEY const * ht_key = HASHMAP_TYPED_FN(key_at_unsafe)(hashmap, index);
+	return HASHMAP_TYPED_EQUALS(ht_key, key);
+}
+
+inline static uint32_t HASHMAP_TYPED_FN(find)(struct Hashmap const * hashmap, HASHMAP_TYPED_KEY const * key, uint32_t hash) {
+	// @note: mirrors `hashmap_find_key_index` and `hashmap_find_frozen_index`,
+	//        but returns `INDEX_EMPTY` instead of a free slot
+	if (hashmap->count == 0) { return INDEX_EMPTY; }
+
+	if (hashmap->seeds != NULL) {
+		uint32_t const seed = hashmap->seeds[HASH_TABLE_WRAP(hash, hashmap->seeds_count)];
+		uint32_t const index = hash_frozen_index(hash, seed, hashmap->count);
+		return HASHMAP_TYPED_FN(is_key_at)(hashmap, index, key, hash) ? index : INDEX_EMPTY;
+	}
+
+	uint8_t const fingerprint = hash_mark_fingerprint(hash);
+	uint32_t const home = HASH_TABLE_WRAP(hash, hashmap->capacity);
+	uint32_t const home_mask = (HASH_GROUP_MASK << (home % HASH_GROUP_WIDTH)) & HASH_GROUP_MASK;
+	uint32_t const groups_count = hashmap->capacity / HASH_GROUP_WIDTH;
+	uint32_t const groups_offset = home / HASH_GROUP_WIDTH;
+
+	if (hashmap->marks[home] == fingerprint && HASHMAP_TYPED_FN(is_key_at)(hashmap, home, key, hash)) {
+		return HASHMAP_TYPED_FN(is_stale)(hashmap, groups_offset) ? INDEX_EMPTY : home;
+	}
+
+	for (uint32_t i = 0; i <= groups_count; i++) {
+		uint32_t const group = HASH_TABLE_WRAP(i + groups_offset, groups_count);
+		if (HASHMAP_TYPED_FN(is_stale)(hashmap, group)) { return INDEX_EMPTY; }
+
+		uint32_t const window = (i == 0) ? home_mask
+			: (i == groups_count) ? (~home_mask & HASH_GROUP_MASK)
+			: HASH_GROUP_MASK;
+
+		uint32_t const offset = group * HASH_GROUP_WIDTH;
+		uint8_t const * marks = hashmap->marks + offset;
+
+		for (uint32_t match = hash_group_match(marks, fingerprint) & window; match != 0; match &= match - 1) {
+			uint32_t const index = offset + hash_group_first(match);
+			if (HASHMAP_TYPED_FN(is_key_at)(hashmap, index, key, hash)) { return index; }
+		}
+
+		if ((hash_group_match_free(marks) & window) != 0) { return INDEX_EMPTY; }
+	}
+
+	return INDEX_EMPTY;
+}
+
+inline static HASHMAP_TYPED_VALUE * HASHMAP_TYPED_FN(get)(struct Hashmap const * hashmap, HASHMAP_TYPED_KEY const * key) {
+	uint32_t const key_index = HASHMAP_TYPED_FN(find)(hashmap, key, HASHMAP_TYPED_HASHER(key));
+	if (key_index == INDEX_EMPTY) { return NULL; }
+	return HASHMAP_TYPED_FN(val_at_unsafe)(hashmap, key_index);
+}
+
+inline static bool HASHMAP_TYPED_FN(set)(struct Hashmap * hashmap, HASHMAP_TYPED_KEY const * key, HASHMAP_TYPED_VALUE const * value) {
+	uint32_t const key_index = HASHMAP_TYPED_FN(find)(hashmap, key, HASHMAP_TYPED_HASHER(key));
+	if (key_index == INDEX_EMPTY) { return hashmap_set(hashmap, key, value); }
+	*HASHMAP_TYPED_FN(val_at_unsafe)(hashmap, key_index) = *value;
+	return false;
+}
+
+#undef HASHMAP_TYPED_FN
+
+#undef HASHMAP_TYPED_NAME
+#undef HASHMAP_TYPED_KEY
+#undef HASHMAP_TYPED_VALUE
+#undef HASHMAP_TYPED_HASHER
+#undef HASHMAP_TYPED_EQUALS
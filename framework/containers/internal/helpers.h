@@ -7,14 +7,32 @@
 
 #define HASH_PO2
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define HASH_SSE2
+#endif
+
+#include "framework/__warnings_push.h"
+	#if defined(HASH_SSE2)
+		#include <emmintrin.h>
+	#endif
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+	#endif
+#include "framework/__warnings_pop.h"
+
 //
 
+// @note: a full mark is a 7-bit fingerprint of the hash, see `hash_mark_fingerprint`;
+// a skipped one is only transient, e.g. pending during an in-place rehash
 enum Hash_Mark {
-	HASH_MARK_NONE,
-	HASH_MARK_SKIP,
-	HASH_MARK_FULL,
+	HASH_MARK_NONE = 0x80,
+	HASH_MARK_SKIP = 0xfe,
 };
 
+// @note: marks are probed by groups; hash tables capacity is a multiple of it
+#define HASH_GROUP_WIDTH 16
+#define HASH_GROUP_MASK  0xffffu
+
 //
 
 uint32_t growth_adjust_array(uint32_t current, uint32_t target);
@@ -31,4 +49,82 @@ uint32_t growth_hash_adjust(uint32_t current, uint32_t target);
 	#define HASH_TABLE_WRAP(value, range) ((value) % (range))
 #endif
 
+inline static bool hash_mark_is_full(uint8_t mark) {
+	return (mark & HASH_MARK_NONE) == 0;
+}
+
+inline static uint8_t hash_mark_fingerprint(uint32_t hash) {
+	// @note: positions come from the lower bits, so take the upper ones of a Fibonacci product
+	return (uint8_t)((hash * 2654435769u) >> 25);
+}
+
+// @note: returns a bitmask of the group marks equal to the `mark`
+inline static uint32_t hash_group_match(uint8_t const * group, uint8_t mark) {
+#if defined(HASH_SSE2)
+	__m128i const marks = _mm_loadu_si128((__m128i const *)(void const *)group);
+	__m128i const match = _mm_cmpeq_epi8(marks, _mm_set1_epi8((char)mark));
+	return (uint32_t)_mm_movemask_epi8(match);
+#else
+	uint32_t result = 0;
+	for (uint32_t i = 0; i < HASH_GROUP_WIDTH; i++) {
+		if (group[i] == mark) { result |= 1u << i; }
+	}
+	return result;
+#endif
+}
+
+// @note: returns a bitmask of the group marks that are either empty or skipped
+inline static uint32_t hash_group_match_free(uint8_t const * group) {
+#if defined(HASH_SSE2)
+	__m128i const marks = _mm_loadu_si128((__m128i const *)(void const *)group);
+	return (uint32_t)_mm_movemask_epi8(marks);
+#else
+	uint32_t result = 0;
+	for (uint32_t i = 0; i < HASH_GROUP_WIDTH; i++) {
+		if (!hash_mark_is_full(group[i])) { result |= 1u << i; }
+	}
+	return result;
+#endif
+}
+
+// @note: a slot of a frozen, minimal perfect hash table, see `hashmap_freeze`;
+// Murmur3 finalizer of the seeded hash, then a multiply-shift range reduction
+inline static uint32_t hash_frozen_index(uint32_t hash, uint32_t seed, uint32_t count) {
+	uint32_t value = hash ^ (seed * 2654435769u);
+	value ^= value >> 16; value *= 0x85ebca6bu;
+	value ^= value >> 13; value *= 0xc2b2ae35u;
+	value ^= value >> 16;
+	return (uint32_t)(((uint64_t)value * count) >> 32);
+}
+
+// @note: a bucket of a frozen table; hashers might be as plain as `hash32`,
+// thus the hash is mixed too, with a seed that placement never reaches
+inline static uint32_t hash_frozen_bucket(uint32_t hash, uint32_t count) {
+	return hash_frozen_index(hash, UINT32_MAX, count);
+}
+
+inline static void hash_prefetch(void const * address) {
+#if defined(__clang__) || defined(__GNUC__)
+	__builtin_prefetch(address);
+#elif defined(HASH_SSE2)
+	_mm_prefetch((char const *)address, _MM_HINT_T0);
+#else
+	(void)address;
+#endif
+}
+
+inline static uint32_t hash_group_first(uint32_t mask) {
+#if defined(__clang__) || defined(__GNUC__)
+	return (uint32_t)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+	unsigned long result;
+	_BitScanForward(&result, mask);
+	return (uint32_t)result;
+#else
+	uint32_t result = 0;
+	while ((mask & 1) == 0) { mask >>= 1; result++; }
+	return result;
+#endif
+}
+
 #endif
@@ -0,0 +1,101 @@
+#include "framework/maths.h"
+#include "framework/formatter.h"
+#include "framework/systems/memory.h"
+
+#include "internal/helpers.h"
+
+
+//
+#include "smallarray.h"
+
+inline static bool smallarray_is_inline(struct Smallarray const * array) {
+	return (size_t)array->value_size * array->capacity <= SMALLARRAY_INLINE_SIZE;
+}
+
+struct Smallarray smallarray_init(uint32_t value_size) {
+	return (struct Smallarray){
+		.value_size = value_size,
+	};
+}
+
+void smallarray_free(struct Smallarray * array) {
+	if (!smallarray_is_inline(array)) {
+		realloc_context(array->allocate, array->context, array->as.data, 0);
+	}
+	cbuffer_clear(CBMP_(array));
+}
+
+void smallarray_clear(struct Smallarray * array) {
+	array->count = 0;
+}
+
+void smallarray_ensure(struct Smallarray * array, uint32_t capacity) {
+	if (array->capacity >= capacity) { return; }
+
+	uint32_t const inline_capacity = SMALLARRAY_INLINE_SIZE / array->value_size;
+	if (capacity <= inline_capacity) {
+		array->capacity = inline_capacity;
+		return;
+	}
+
+	if (array->allocate == NULL) {
+		array->allocate = DEFAULT_REALLOCATOR;
+	}
+
+	capacity = growth_adjust_array(array->capacity, capacity);
+
+	// @note: the inline buffer and the pointer overlap, copy the elements out first
+	bool const is_inline = smallarray_is_inline(array);
+	void * data = realloc_context(array->allocate, array->context, is_inline ? NULL : array->as.data, (size_t)array->value_size * capacity);
+	if (data == NULL) { return; }
+	if (is_inline) {
+		common_memcpy(data, array->as.buffer, (size_t)array->value_size * array->count);
+	}
+
+	array->as.data = data;
+	array->capacity = capacity;
+}
+
+void smallarray_push_many(struct Smallarray * array, uint32_t count, void const * value) {
+	smallarray_ensure(array, array->count + count);
+	uint8_t * end = smallarray_at_unsafe(array, array->count);
+	common_memcpy(end, value, (size_t)array->value_size * count);
+	array->count += count;
+}
+
+void * smallarray_pop(struct Smallarray * array, uint32_t count) {
+	if (array->count < count) {
+		ERR("out of bounds");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL;
+	}
+	array->count -= count;
+	return smallarray_at_unsafe(array, array->count);
+}
+
+void * smallarray_at(struct Smallarray const * array, uint32_t index) {
+	if (index >= array->count) {
+		ERR("out of bounds");
+		REPORT_CALLSTACK(); DEBUG_BREAK(); return NULL;
+	}
+	return smallarray_at_unsafe(array, index);
+}
+
+void * smallarray_at_unsafe(struct Smallarray const * array, uint32_t index) {
+	// @note: places that call it should do the check
+	// @note: the const is laundered on purpose, to match `array_at_unsafe`: a const
+	//        container still yields mutable elements; unlike the pointer of an array,
+	//        the inline buffer is a field, thus const through a const array
+	uint8_t * data = smallarray_is_inline(array) ? (uint8_t *)(size_t)array->as.buffer : array->as.data;
+	size_t const offset = (size_t)array->value_size * index;
+	return data + offset;
+}
+
+bool smallarray_iterate(struct Smallarray const * array, struct Smallarray_Iterator * iterator) {
+	while (iterator->next < array->count) {
+		uint32_t const index = iterator->next++;
+		iterator->curr  = index;
+		iterator->value = smallarray_at_unsafe(array, index);
+		return true;
+	}
+	return false;
+}
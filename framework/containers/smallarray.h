@@ -0,0 +1,46 @@
+#if !defined(FRAMEWORK_CONTAINERS_smallarray)
+#define FRAMEWORK_CONTAINERS_smallarray
+
+#include "framework/common.h"
+
+struct Smallarray_Iterator {
+	uint32_t curr, next;
+	void * value;
+};
+
+// @note: bytes of elements kept inside the struct itself, before spilling to `allocate`
+#define SMALLARRAY_INLINE_SIZE 16
+
+// @note: same as `struct Array`, but the first few elements cost no allocations;
+// the storage is resolved on every access, so the struct is safe to be moved
+struct Smallarray {
+	Allocator * allocate;
+	struct Allocator_Context * context; // overrides `allocate`, if set
+	uint32_t value_size;
+	uint32_t capacity, count;
+	union {
+		uint8_t buffer[SMALLARRAY_INLINE_SIZE]; // while `capacity * value_size` fits
+		void * data;                            // once spilled
+	} as;
+};
+
+struct Smallarray smallarray_init(uint32_t value_size);
+void smallarray_free(struct Smallarray * array);
+
+void smallarray_clear(struct Smallarray * array);
+void smallarray_ensure(struct Smallarray * array, uint32_t capacity);
+
+void smallarray_push_many(struct Smallarray * array, uint32_t count, void const * value);
+void * smallarray_pop(struct Smallarray * array, uint32_t count);
+void * smallarray_at(struct Smallarray const * array, uint32_t index);
+
+void * smallarray_at_unsafe(struct Smallarray const * array, uint32_t index);
+
+bool smallarray_iterate(struct Smallarray const * array, struct Smallarray_Iterator * iterator);
+
+#define FOR_SMALLARRAY(data, it) for ( \
+	struct Smallarray_Iterator it = {0}; \
+	smallarray_iterate(data, &it); \
+) \
+
+#endif
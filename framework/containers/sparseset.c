@@ -21,6 +21,12 @@ void sparseset_free(struct Sparseset * sparseset) {
 	cbuffer_clear(CBMP_(sparseset));
 }
 
+void sparseset_set_context(struct Sparseset * sparseset, struct Allocator_Context * context) {
+	sparseset->payload.context = context;
+	sparseset->packed.context  = context;
+	sparseset->sparse.context  = context;
+}
+
 void sparseset_clear(struct Sparseset * sparseset) {
 	array_clear(&sparseset->payload);
 	array_clear(&sparseset->packed); sparseset->packed.count = sparseset->packed.capacity;
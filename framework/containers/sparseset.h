@@ -19,6 +19,9 @@ struct Sparseset {
 struct Sparseset sparseset_init(uint32_t value_size);
 void sparseset_free(struct Sparseset * sparseset);
 
+// @note: applies to all the arrays; set it before the first allocation
+void sparseset_set_context(struct Sparseset * sparseset, struct Allocator_Context * context);
+
 void sparseset_clear(struct Sparseset * sparseset);
 void sparseset_ensure(struct Sparseset * sparseset, uint32_t capacity);
 
@@ -0,0 +1,17 @@
+#if !defined(FRAMEWORK_CONTAINERS_TYPED)
+#define FRAMEWORK_CONTAINERS_TYPED
+
+// @purpose: shared instances of typed containers functions, see "array_typed.h" and "hashmap_typed.h"
+
+#define ARRAY_TYPED_NAME  u32
+#define ARRAY_TYPED_VALUE uint32_t
+#include "array_typed.h"
+
+#define HASHMAP_TYPED_NAME   handle_handle
+#define HASHMAP_TYPED_KEY    struct Handle
+#define HASHMAP_TYPED_VALUE  struct Handle
+#define HASHMAP_TYPED_HASHER hash32
+#define HASHMAP_TYPED_EQUALS(key1, key2) handle_equals(*(key1), *(key2))
+#include "hashmap_typed.h"
+
+#endif
@@ -2,6 +2,7 @@
 #include "framework/graphics/gfx_types.h"
 #include "framework/graphics/gfx_objects.h"
 #include "framework/systems/strings.h"
+#include "framework/systems/memory.h"
 
 
 //
@@ -18,17 +19,36 @@ struct Gfx_Uniforms gfx_uniforms_init(void) {
 	};
 }
 
+struct Gfx_Uniforms gfx_uniforms_init_frame(uint32_t count, size_t size) {
+	struct Gfx_Uniforms result = gfx_uniforms_init();
+	gfx_uniforms_set_allocator(&result, realloc_frame, NULL);
+	gfx_uniforms_reserve(&result, count, size);
+	return result;
+}
+
 void gfx_uniforms_free(struct Gfx_Uniforms * uniforms) {
 	array_free(&uniforms->headers);
 	buffer_free(&uniforms->payload);
 	// cbuffer_clear(CBMP_(uniforms));
 }
 
+void gfx_uniforms_set_allocator(struct Gfx_Uniforms * uniforms, Allocator * allocate, struct Allocator_Context * context) {
+	uniforms->headers.allocate = allocate;
+	uniforms->payload.allocate = allocate;
+	uniforms->headers.context = context;
+	uniforms->payload.context = context;
+}
+
 void gfx_uniforms_clear(struct Gfx_Uniforms * uniforms) {
 	array_clear(&uniforms->headers);
 	buffer_clear(&uniforms->payload);
 }
 
+void gfx_uniforms_reserve(struct Gfx_Uniforms * uniforms, uint32_t count, size_t size) {
+	array_ensure(&uniforms->headers, count);
+	buffer_ensure(&uniforms->payload, size);
+}
+
 struct CBuffer_Mut gfx_uniforms_get(struct Gfx_Uniforms const * uniforms, struct CString name, uint32_t offset) {
 	struct Handle const sh_name = system_strings_find(name);
 	return gfx_uniforms_id_get(uniforms, sh_name, offset);
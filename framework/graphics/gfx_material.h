@@ -28,9 +28,13 @@ struct Gfx_Uniforms {
 };
 
 struct Gfx_Uniforms gfx_uniforms_init(void);
+struct Gfx_Uniforms gfx_uniforms_init_frame(uint32_t count, size_t size);
 void gfx_uniforms_free(struct Gfx_Uniforms * uniforms);
 
+void gfx_uniforms_set_allocator(struct Gfx_Uniforms * uniforms, Allocator * allocate, struct Allocator_Context * context);
+
 void gfx_uniforms_clear(struct Gfx_Uniforms * uniforms);
+void gfx_uniforms_reserve(struct Gfx_Uniforms * uniforms, uint32_t count, size_t size);
 
 struct CBuffer_Mut gfx_uniforms_get(struct Gfx_Uniforms const * uniforms, struct CString name, uint32_t offset);
 void gfx_uniforms_push(struct Gfx_Uniforms * uniforms, struct CString name, struct CBuffer value);
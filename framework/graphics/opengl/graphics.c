@@ -211,6 +211,9 @@ static void gpu_program_introspect_uniforms(struct GPU_Program_Internal * gpu_pr
 		// @note: this is not necessary, but responsible
 		ARENA_FREE(name_data);
 	}
+
+	// @note: uniforms are only looked up from now on
+	hashmap_freeze(&gpu_program->base.uniforms);
 }
 
 static void gpu_program_introspect_block(struct GPU_Program_Internal * gpu_program, GLenum interface) {
@@ -3,11 +3,10 @@
 #include "framework/parsing.h"
 #include "framework/json_read.h"
 
-#include "framework/platform/file.h"
+#include "framework/systems/packs.h"
 #include "framework/containers/buffer.h"
 #include "framework/systems/memory.h"
 
-#include "framework/graphics/gfx_objects.h"
 #include "framework/assets/json.h"
 
 
@@ -15,13 +14,14 @@
 #include "json_read.h"
 
 void process_json(struct CString path, void * data, JSON_Processor * process) {
-	struct Buffer file_buffer = platform_file_read_entire(path);
+	struct Buffer file_buffer = system_packs_read(path);
 	if (file_buffer.capacity == 0) { process(&c_json_null, data); return; }
 
+	// @note: the value is transient, thus allocated from the arena
 	struct JSON json = json_parse((struct CString){
 		.length = (uint32_t)file_buffer.size,
 		.data = file_buffer.data,
-	});
+	}, realloc_arena, NULL);
 	buffer_free(&file_buffer);
 
 	process(&json, data);
@@ -284,43 +284,3 @@ struct Target_Format json_read_target_format(struct JSON const * json) {
 	REPORT_CALLSTACK(); DEBUG_BREAK();
 	return (struct Target_Format){0};
 }
-
-// ----- ----- ----- ----- -----
-//     graphics objects
-// ----- ----- ----- ----- -----
-
-struct Handle json_read_target(struct JSON const * json) {
-	if (json->type != JSON_OBJECT) { goto fail; }
-
-	struct JSON const * buffers_json = json_get(json, S_("buffers"));
-	if (buffers_json->type != JSON_ARRAY) { goto fail; }
-
-	struct Array formats = array_init(sizeof(struct Target_Format));
-	formats.allocate = realloc_arena;
-
-	uint32_t const buffers_count = json_count(buffers_json);
-	for (uint32_t i = 0; i < buffers_count; i++) {
-		struct Target_Format const format = json_read_target_format(json_at(buffers_json, i));
-		array_push_many(&formats, 1, &format);
-	}
-
-	struct Handle result = (struct Handle){0};
-	if (formats.count > 0) {
-		struct uvec2 size = {0};
-		json_read_many_u32(json_get(json, S_("size")), 2, &size.x);
-		if (size.x > 0 && size.y > 0) {
-			result = gpu_target_init(&(struct GPU_Target_Asset){
-				.size = size,
-				.formats = formats,
-			});
-		}
-	}
-
-	array_free(&formats);
-	return result;
-
-	// process errors
-	fail: ERR("failed to read target asset");
-	REPORT_CALLSTACK(); DEBUG_BREAK();
-	return (struct Handle){0};
-}
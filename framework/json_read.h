@@ -33,10 +33,4 @@ struct Texture_Settings json_read_texture_settings(struct JSON const * json);
 
 struct Target_Format json_read_target_format(struct JSON const * json);
 
-// ----- ----- ----- ----- -----
-//     graphics objects
-// ----- ----- ----- ----- -----
-
-struct Handle json_read_target(struct JSON const * json);
-
 #endif
@@ -1,6 +1,9 @@
 #include "framework/formatter.h"
+#include "framework/maths.h"
+#include "framework/platform/thread.h"
 
 #include <stdlib.h>
+#include <malloc.h>
 
 
 // @idea: use OS-native allocators instead of CRT's
@@ -8,13 +11,47 @@
 //
 #include "allocator.h"
 
+static struct Platform_Allocator_Stats gs_platform_allocator_stats;
+
+inline static size_t platform_allocator_get_size(void * pointer) {
+	if (pointer == NULL) { return 0; }
+#if defined(_WIN32) || defined(_WIN64)
+	return _msize(pointer);
+#else
+	return malloc_usable_size(pointer);
+#endif
+}
+
 ALLOCATOR(platform_reallocate) {
-	if (size == 0) { free(pointer); return NULL; }
+	struct Platform_Allocator_Stats * stats = &gs_platform_allocator_stats;
+	size_t const size_old = platform_allocator_get_size(pointer);
 
-	pointer = realloc(pointer, size);
-	if (pointer != NULL) { return pointer; }
+	if (size == 0) {
+		if (pointer == NULL) { return NULL; }
+		free(pointer);
+		platform_atomic_add_u64(&stats->free, 1);
+		platform_atomic_add_u64(&stats->live, (uint64_t)0 - size_old);
+		return NULL;
+	}
+
+	void * const result = realloc(pointer, size);
+	if (result != NULL) {
+		size_t const size_new = platform_allocator_get_size(result);
+		if (pointer == NULL) { platform_atomic_add_u64(&stats->allocate, 1); }
+		else {
+			platform_atomic_add_u64(&stats->reallocate, 1);
+			if (result != pointer) { platform_atomic_add_u64(&stats->copied, min_size(size_old, size)); }
+		}
+		uint64_t const live = platform_atomic_add_u64(&stats->live, (uint64_t)size_new - size_old) + size_new - size_old;
+		platform_atomic_max_u64(&stats->peak, live);
+		return result;
+	}
 
 	ERR("'realloc' failed:");
 	REPORT_CALLSTACK(); DEBUG_BREAK();
 	return NULL;
 }
+
+struct Platform_Allocator_Stats platform_allocator_get_stats(void) {
+	return gs_platform_allocator_stats;
+}
@@ -5,4 +5,13 @@
 
 ALLOCATOR(platform_reallocate);
 
+// @note: bytes are as reported by the CRT, which rounds blocks up
+struct Platform_Allocator_Stats {
+	uint64_t allocate, reallocate, free; // calls
+	uint64_t copied;                     // bytes moved by reallocations
+	uint64_t live, peak;                 // bytes in use
+};
+
+struct Platform_Allocator_Stats platform_allocator_get_stats(void);
+
 #endif
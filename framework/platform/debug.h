@@ -6,4 +6,7 @@
 struct Callstack platform_debug_get_callstack(uint32_t skip);
 struct CString platform_debug_get_stacktrace(struct Callstack callstack);
 
+// @note: the result is valid until the next call
+struct CString platform_debug_get_symbol(uint64_t address);
+
 #endif
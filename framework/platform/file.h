@@ -17,6 +17,16 @@ enum File_Mode {
 struct Buffer platform_file_read_entire(struct CString path);
 bool platform_file_delete(struct CString path);
 
+// @note: a read-only view of the whole file, empty if there is none
+struct CBuffer platform_file_map(struct CString path);
+void platform_file_unmap(struct CBuffer view);
+
+// @note: visits files recursively; paths are `/`-separated, prefixed with the directory
+#define FILE_VISITOR(func) void (func)(struct CString path, void * data)
+typedef FILE_VISITOR(File_Visitor);
+
+void platform_file_iterate(struct CString directory, File_Visitor * visit, void * data);
+
 struct File * platform_file_init(struct CString path, enum File_Mode mode);
 void platform_file_free(struct File * file);
 
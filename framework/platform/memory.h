@@ -0,0 +1,16 @@
+#if !defined(FRAMEWORK_PLATFORM_MEMORY)
+#define FRAMEWORK_PLATFORM_MEMORY
+
+#include "framework/common.h"
+
+// @note: `pointer` and `size` are expected to be multiples of the page size;
+// reserved address space is inaccessible until committed
+size_t platform_memory_get_page_size(void);
+
+void * platform_memory_reserve(size_t size);
+void platform_memory_release(void * pointer, size_t size);
+
+bool platform_memory_commit(void * pointer, size_t size);
+void platform_memory_decommit(void * pointer, size_t size);
+
+#endif
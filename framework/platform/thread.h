@@ -0,0 +1,51 @@
+#if !defined(FRAMEWORK_PLATFORM_THREAD)
+#define FRAMEWORK_PLATFORM_THREAD
+
+#include "framework/common.h"
+
+#define THREAD_PROC(func) void (func)(void * data)
+typedef THREAD_PROC(Thread_Proc);
+
+void * platform_thread_start(Thread_Proc * proc, void * data);
+void platform_thread_join(void * thread);
+
+uint32_t platform_thread_get_id(void);
+uint32_t platform_thread_get_cores(void); // logical processors
+
+// ----- ----- ----- ----- -----
+//     locks
+// ----- ----- ----- ----- -----
+
+// @note: zero initialized is unlocked; not recursive
+struct Platform_Lock {
+	void * data;
+};
+
+void platform_lock_acquire(struct Platform_Lock * lock);
+void platform_lock_release(struct Platform_Lock * lock);
+
+// ----- ----- ----- ----- -----
+//     conditions
+// ----- ----- ----- ----- -----
+
+// @note: zero initialized is ready; waits release the lock while asleep,
+//        can wake spuriously, thus should be looped over a predicate
+struct Platform_Condition {
+	void * data;
+};
+
+void platform_condition_wait(struct Platform_Condition * condition, struct Platform_Lock * lock);
+void platform_condition_signal(struct Platform_Condition * condition);
+void platform_condition_broadcast(struct Platform_Condition * condition);
+
+// ----- ----- ----- ----- -----
+//     atomics
+// ----- ----- ----- ----- -----
+
+// @note: sequentially consistent; return the previous values
+uint32_t platform_atomic_add_u32(uint32_t volatile * target, uint32_t value);
+uint64_t platform_atomic_add_u64(uint64_t volatile * target, uint64_t value);
+uint64_t platform_atomic_max_u64(uint64_t volatile * target, uint64_t value);
+void * platform_atomic_compare_exchange(void * volatile * target, void * expected, void * value);
+
+#endif
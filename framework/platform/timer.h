@@ -5,5 +5,6 @@
 
 uint64_t platform_timer_get_ticks(void);
 uint64_t platform_timer_get_ticks_per_second(void);
+double platform_timer_get_millis(uint64_t ticks);
 
 #endif
@@ -132,6 +132,29 @@ struct CString platform_debug_get_stacktrace(struct Callstack callstack) {
 	// https://learn.microsoft.com/windows/win32/api/dbghelp/nf-dbghelp-symgetlinefromaddr64
 }
 
+struct CString platform_debug_get_symbol(uint64_t address) {
+	if (gs_platform_debug.buffer.allocate == NULL) { return (struct CString){0}; }
+
+	static union {
+		SYMBOL_INFO header;
+		uint8_t payload[sizeof(SYMBOL_INFO) + 1024];
+	} symbol;
+	symbol.header = (SYMBOL_INFO){
+		.SizeOfStruct  = sizeof(symbol.header),
+		.MaxNameLen = sizeof(symbol.payload) - sizeof(symbol.header),
+	};
+
+	DWORD64 symbol_offset = 0;
+	if (!SymFromAddr(GetCurrentProcess(), address, &symbol_offset, &symbol.header)) {
+		return (struct CString){0};
+	}
+
+	return (struct CString){
+		.length = (uint32_t)symbol.header.NameLen,
+		.data = symbol.header.Name,
+	};
+}
+
 //
 #include "internal/debug_to_system.h"
 
@@ -161,6 +184,7 @@ void debug_to_system_free(void) {
 
 struct Callstack platform_debug_get_callstack(uint32_t skip) { (void)skip; return (struct Callstack){0}; }
 struct CString platform_debug_get_stacktrace(struct Callstack callstack) { (void)callstack; return (struct CString){0}; }
+struct CString platform_debug_get_symbol(uint64_t address) { (void)address; return (struct CString){0}; }
 
 //
 #include "internal/debug_to_system.h"
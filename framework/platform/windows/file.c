@@ -154,6 +154,49 @@ uint64_t platform_file_write(struct File * file, uint8_t * buffer, uint64_t size
 	return written;
 }
 
+struct CBuffer platform_file_map(struct CString path) {
+	struct CBuffer result = {0};
+	if (path.data == NULL) { return result; }
+
+	HANDLE const handle = platform_file_internal_create(path, FILE_MODE_NONE);
+	if (handle == INVALID_HANDLE_VALUE) { return result; }
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(handle, &file_size)) { goto finalize; }
+	if (file_size.QuadPart == 0) { goto finalize; }
+
+	HANDLE const mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) { goto finalize; }
+
+	// @note: the view keeps the mapping alive
+	void const * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+
+	if (view != NULL) {
+		result = (struct CBuffer){
+			.size = (size_t)file_size.QuadPart,
+			.data = view,
+		};
+	}
+
+	finalize:
+	CloseHandle(handle);
+	return result;
+}
+
+void platform_file_unmap(struct CBuffer view) {
+	if (view.data == NULL) { return; }
+	UnmapViewOfFile(view.data);
+}
+
+static void platform_file_internal_iterate(struct Buffer * path, File_Visitor * visit, void * data);
+void platform_file_iterate(struct CString directory, File_Visitor * visit, void * data) {
+	struct Buffer path = buffer_init();
+	buffer_push_many(&path, directory.length, directory.data);
+	platform_file_internal_iterate(&path, visit, data);
+	buffer_free(&path);
+}
+
 //
 
 static HANDLE platform_file_internal_create(struct CString path, enum File_Mode mode) {
@@ -174,3 +217,37 @@ static HANDLE platform_file_internal_create(struct CString path, enum File_Mode
 		FILE_ATTRIBUTE_NORMAL, NULL
 	);
 }
+
+static void platform_file_internal_iterate(struct Buffer * path, File_Visitor * visit, void * data) {
+	size_t const path_size = path->size;
+
+	buffer_push_many(path, 3, "/*\0");
+	WIN32_FIND_DATAA entry;
+	HANDLE const handle = FindFirstFileA(path->data, &entry);
+	path->size = path_size;
+	if (handle == INVALID_HANDLE_VALUE) { return; }
+
+	do {
+		char const * name = entry.cFileName;
+		if (name[0] == '.' && name[1] == '\0') { continue; }
+		if (name[0] == '.' && name[1] == '.' && name[2] == '\0') { continue; }
+
+		buffer_push_many(path, 1, "/");
+		buffer_push_many(path, find_null(name) + 1, name);
+		path->size--;
+
+		if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			platform_file_internal_iterate(path, visit, data);
+		}
+		else {
+			visit((struct CString){
+				.length = (uint32_t)path->size,
+				.data = path->data,
+			}, data);
+		}
+
+		path->size = path_size;
+	} while (FindNextFileA(handle, &entry));
+
+	FindClose(handle);
+}
@@ -0,0 +1,44 @@
+#include "framework/formatter.h"
+
+#include "__platform.h"
+
+
+//
+#include "framework/platform/memory.h"
+
+size_t platform_memory_get_page_size(void) {
+	static size_t page_size = 0;
+	if (page_size == 0) {
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		page_size = (size_t)info.dwPageSize;
+	}
+	return page_size;
+}
+
+void * platform_memory_reserve(size_t size) {
+	void * pointer = VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+	if (pointer != NULL) { return pointer; }
+
+	ERR("'VirtualAlloc' failed to reserve:");
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	return NULL;
+}
+
+void platform_memory_release(void * pointer, size_t size) {
+	(void)size;
+	if (pointer == NULL) { return; }
+	VirtualFree(pointer, 0, MEM_RELEASE);
+}
+
+bool platform_memory_commit(void * pointer, size_t size) {
+	if (VirtualAlloc(pointer, size, MEM_COMMIT, PAGE_READWRITE) != NULL) { return true; }
+
+	ERR("'VirtualAlloc' failed to commit:");
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	return false;
+}
+
+void platform_memory_decommit(void * pointer, size_t size) {
+	VirtualFree(pointer, size, MEM_DECOMMIT);
+}
@@ -0,0 +1,110 @@
+#include "framework/formatter.h"
+#include "framework/platform/allocator.h"
+
+#include "__platform.h"
+
+
+//
+#include "framework/platform/thread.h"
+
+struct Thread_Start {
+	Thread_Proc * proc;
+	void * data;
+};
+
+static DWORD WINAPI thread_entry(LPVOID parameter) {
+	struct Thread_Start const start = *(struct Thread_Start *)parameter;
+	platform_reallocate(parameter, 0);
+	start.proc(start.data);
+	return 0;
+}
+
+void * platform_thread_start(Thread_Proc * proc, void * data) {
+	struct Thread_Start * start = platform_reallocate(NULL, sizeof(*start));
+	*start = (struct Thread_Start){
+		.proc = proc,
+		.data = data,
+	};
+
+	HANDLE const handle = CreateThread(NULL, 0, thread_entry, start, 0, NULL);
+	if (handle != NULL) { return handle; }
+
+	platform_reallocate(start, 0);
+	ERR("'CreateThread' failed:");
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	return NULL;
+}
+
+void platform_thread_join(void * thread) {
+	if (thread == NULL) { return; }
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+
+uint32_t platform_thread_get_id(void) {
+	return (uint32_t)GetCurrentThreadId();
+}
+
+uint32_t platform_thread_get_cores(void) {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (uint32_t)info.dwNumberOfProcessors;
+}
+
+// ----- ----- ----- ----- -----
+//     locks
+// ----- ----- ----- ----- -----
+
+STATIC_ASSERT(sizeof(struct Platform_Lock) == sizeof(SRWLOCK), thread);
+
+void platform_lock_acquire(struct Platform_Lock * lock) {
+	AcquireSRWLockExclusive((SRWLOCK *)lock);
+}
+
+void platform_lock_release(struct Platform_Lock * lock) {
+	ReleaseSRWLockExclusive((SRWLOCK *)lock);
+}
+
+// ----- ----- ----- ----- -----
+//     conditions
+// ----- ----- ----- ----- -----
+
+STATIC_ASSERT(sizeof(struct Platform_Condition) == sizeof(CONDITION_VARIABLE), thread);
+
+void platform_condition_wait(struct Platform_Condition * condition, struct Platform_Lock * lock) {
+	SleepConditionVariableSRW((CONDITION_VARIABLE *)condition, (SRWLOCK *)lock, INFINITE, 0);
+}
+
+void platform_condition_signal(struct Platform_Condition * condition) {
+	WakeConditionVariable((CONDITION_VARIABLE *)condition);
+}
+
+void platform_condition_broadcast(struct Platform_Condition * condition) {
+	WakeAllConditionVariable((CONDITION_VARIABLE *)condition);
+}
+
+// ----- ----- ----- ----- -----
+//     atomics
+// ----- ----- ----- ----- -----
+
+uint32_t platform_atomic_add_u32(uint32_t volatile * target, uint32_t value) {
+	return (uint32_t)InterlockedExchangeAdd((LONG volatile *)target, (LONG)value);
+}
+
+uint64_t platform_atomic_add_u64(uint64_t volatile * target, uint64_t value) {
+	return (uint64_t)InterlockedExchangeAdd64((LONG64 volatile *)target, (LONG64)value);
+}
+
+uint64_t platform_atomic_max_u64(uint64_t volatile * target, uint64_t value) {
+	uint64_t previous = *target;
+	while (previous < value) {
+		uint64_t const actual = (uint64_t)InterlockedCompareExchange64((LONG64 volatile *)target, (LONG64)value, (LONG64)previous);
+		if (actual == previous) { break; }
+		previous = actual;
+	}
+	return previous;
+}
+
+void * platform_atomic_compare_exchange(void * volatile * target, void * expected, void * value) {
+	return InterlockedCompareExchangePointer(target, value, expected);
+}
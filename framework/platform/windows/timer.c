@@ -22,3 +22,7 @@ uint64_t platform_timer_get_ticks_per_second(void) {
 	}
 	return (uint64_t)frequency.QuadPart;
 }
+
+double platform_timer_get_millis(uint64_t ticks) {
+	return (double)ticks * 1000.0 / (double)platform_timer_get_ticks_per_second();
+}
@@ -1,18 +1,33 @@
 #include "framework/formatter.h"
 #include "framework/containers/hashmap.h"
 #include "framework/containers/sparseset.h"
+#include "framework/containers/smallarray.h"
+#include "framework/containers/typed.h"
+#include "framework/systems/memory.h"
 #include "framework/systems/strings.h"
+#include "framework/systems/jobs.h"
 
 
 //
 #include "assets.h"
 
 struct Asset_Meta {
-	struct Array dependencies; // meta `struct Handle`
-	struct Handle inst_handle; // into `struct Asset_Type : instances`
-	struct Handle sh_type;     // get `struct CString` via `system_strings_get`
-	struct Handle sh_name;     // get `struct CString` via `system_strings_get`
-	uint32_t ref_count;        // zero-based
+	struct Smallarray dependencies; // meta `struct Handle`; mostly a few of them
+	struct Handle inst_handle;      // into `struct Asset_Type : instances`
+	struct Handle sh_type;          // get `struct CString` via `system_strings_get`
+	struct Handle sh_name;          // get `struct CString` via `system_strings_get`
+	uint32_t ref_count;             // zero-based
+	struct Asset_Async * async;     // while pending
+	void * staged;                  // while loading
+	uint64_t cached_size;           // while unreferenced
+	bool cached;
+};
+
+struct Asset_Async {
+	struct Jobs_Group group;
+	Asset_Prepare * prepare;
+	struct CString name; // a copy, as strings might move meanwhile
+	void * staged;
 };
 
 struct Asset_Inst {
@@ -25,55 +40,83 @@ struct Asset_Inst {
 struct Asset_Type {
 	struct Asset_Info info;
 	struct Sparseset instances; // `struct Asset_Inst`
+	struct Array cache;         // meta `struct Handle`; least recently dropped first
+	struct Asset_Cache_Stats cache_stats;
 };
 
+#define HASHMAP_TYPED_NAME   handle_asset_type
+#define HASHMAP_TYPED_KEY    struct Handle
+#define HASHMAP_TYPED_VALUE  struct Asset_Type
+#define HASHMAP_TYPED_HASHER hash32
+#define HASHMAP_TYPED_EQUALS(key1, key2) handle_equals(*(key1), *(key2))
+#include "framework/containers/hashmap_typed.h"
+
 static struct Assets {
+	struct Memory_Heap * heap; // of the containers
 	struct Sparseset meta;  // `struct Asset_Meta`
 	struct Hashmap handles; // name `struct Handle` : meta `struct Handle`
 	struct Hashmap types;   // type `struct Handle` : `struct Asset_Type`
 	struct Hashmap map;     // extension `struct Handle` : type `struct Handle`
 	struct Array stack;     // meta `struct Handle`
+	struct Array pending;   // meta `struct Handle`
 } gs_assets;
 
+static struct Handle system_assets_load_internal(struct CString name, bool async);
+static void system_assets_invoke_load(struct Asset_Type const * type, struct Handle handle, void * staged);
+static HANDLE_ACTION(system_assets_finalize);
+static HANDLE_ACTION(system_assets_destroy);
+static void system_assets_cache(struct Asset_Type * type, struct Handle handle);
+static void system_assets_uncache(struct Asset_Type * type, struct Handle handle);
+static void system_assets_evict(struct Asset_Type * type);
+static void system_assets_trim(struct Asset_Type * type);
+static void system_assets_wait_all(void);
+static THREAD_PROC(system_assets_prepare_job);
 static HANDLE_ACTION(system_assets_add_dependency);
 static void system_assets_report(struct CString tag, struct Handle handle);
+static struct Asset_Type * system_assets_name_to_type(struct CString name, struct Handle * sh_type);
 static struct CString system_assets_name_to_extension(struct CString name);
 
 void system_assets_init(void) {
+	struct Memory_Heap * heap = system_memory_heap_init(S_("assets"), NULL);
+	struct Allocator_Context * context = system_memory_heap_get_context(heap);
+
 	gs_assets = (struct Assets){
+		.heap = heap,
 		.meta = {
 			.payload = {
+				.context = context,
 				.value_size = sizeof(struct Asset_Meta),
 			},
 			.sparse = {
+				.context = context,
 				.value_size = sizeof(struct Handle),
 			},
 			.packed = {
+				.context = context,
 				.value_size = sizeof(uint32_t),
 			},
 		},
-		.handles = {
-			.get_hash = hash32,
-			.key_size = sizeof(uint32_t),
+		.handles = hashmap_handle_handle_init(),
+		.types   = hashmap_handle_asset_type_init(),
+		.map     = hashmap_handle_handle_init(),
+		.stack = {
+			.context = context,
 			.value_size = sizeof(struct Handle),
 		},
-		.types = {
-			.get_hash = hash32,
-			.key_size = sizeof(uint32_t),
-			.value_size = sizeof(struct Asset_Type),
-		},
-		.map = {
-			.get_hash = hash32,
-			.key_size = sizeof(uint32_t),
-			.value_size = sizeof(uint32_t),
-		},
-		.stack = {
+		.pending = {
+			.context = context,
 			.value_size = sizeof(struct Handle),
 		},
 	};
+	gs_assets.handles.context = context;
+	gs_assets.types.context   = context;
+	gs_assets.map.context     = context;
 }
 
 void system_assets_free(void) {
+	system_assets_wait_all();
+	system_assets_flush();
+
 	uint32_t dropped_count = 0;
 	FOR_HASHMAP(&gs_assets.types, it_type) {
 		struct Asset_Type * type = it_type.value;
@@ -85,18 +128,12 @@ void system_assets_free(void) {
 				type->info.drop(inst->header.ah_meta);
 			}
 		}
-		sparseset_free(&type->instances);
 	}
 	if (dropped_count > 0) { DEBUG_BREAK(); }
-	FOR_SPARSESET(&gs_assets.meta, it) {
-		struct Asset_Meta * meta = it.value;
-		array_free(&meta->dependencies);
-	}
-	sparseset_free(&gs_assets.meta);
-	hashmap_free(&gs_assets.handles);
-	hashmap_free(&gs_assets.types);
-	hashmap_free(&gs_assets.map);
-	array_free(&gs_assets.stack);
+
+	// @note: the containers are on the heap, thus are released at once
+	system_memory_heap_free(gs_assets.heap);
+	cbuffer_clear(CBM_(gs_assets));
 }
 
 void system_assets_type_map(struct CString type, struct CString extension) {
@@ -104,7 +141,7 @@ void system_assets_type_map(struct CString type, struct CString extension) {
 	if (handle_is_null(sh_type)) { WRN("empty type"); goto fail; }
 	struct Handle const sh_extension = system_strings_add(extension);
 	if (handle_is_null(sh_extension)) { WRN("empty extension"); goto fail; }
-	hashmap_set(&gs_assets.map, &sh_extension, &sh_type);
+	hashmap_handle_handle_set(&gs_assets.map, &sh_extension, &sh_type);
 
 	return;
 	fail:
@@ -113,17 +150,27 @@ void system_assets_type_map(struct CString type, struct CString extension) {
 
 void system_assets_type_set(struct CString type_name, struct Asset_Info info) {
 	struct Handle const sh_type = system_strings_add(type_name);
-	hashmap_set(&gs_assets.types, &sh_type, &(struct Asset_Type){
+	struct Sparseset instances = sparseset_init(SIZE_OF_MEMBER(struct Asset_Inst, header) + info.size);
+	sparseset_set_context(&instances, system_memory_heap_get_context(gs_assets.heap));
+	hashmap_handle_asset_type_set(&gs_assets.types, &sh_type, &(struct Asset_Type){
 		.info = info,
-		.instances = sparseset_init(SIZE_OF_MEMBER(struct Asset_Inst, header) + info.size),
+		.instances = instances,
+		.cache = {
+			.context = system_memory_heap_get_context(gs_assets.heap),
+			.value_size = sizeof(struct Handle),
+		},
 	});
 }
 
 void system_assets_type_del(struct CString type_name) {
 	struct Handle const sh_type = system_strings_find(type_name);
-	struct Asset_Type * type = hashmap_get(&gs_assets.types, &sh_type);
+	struct Asset_Type * type = hashmap_handle_asset_type_get(&gs_assets.types, &sh_type);
 	if (type == NULL) { return; }
 
+	system_assets_wait_all();
+	type = hashmap_handle_asset_type_get(&gs_assets.types, &sh_type);
+	while (type->cache.count > 0) { system_assets_evict(type); }
+
 	uint32_t const inst_count = sparseset_get_count(&type->instances);
 
 	LOG("[type] %.*s\n", type_name.length, type_name.data);
@@ -143,57 +190,203 @@ void system_assets_type_del(struct CString type_name) {
 		if (meta == NULL) { WRN("inst w/o meta"); DEBUG_BREAK(); goto cleanup; }
 
 		array_push_many(&gs_assets.stack, 1, &ah_meta);
-		FOR_ARRAY(&meta->dependencies, it_dpdc) {
+		FOR_SMALLARRAY(&meta->dependencies, it_dpdc) {
 			struct Handle const * ah_meta_child = it_dpdc.value;
 			system_assets_drop(*ah_meta_child);
 		}
 		array_pop(&gs_assets.stack, 1);
-		array_free(&meta->dependencies);
+		smallarray_free(&meta->dependencies);
 
 		hashmap_del(&gs_assets.handles, &meta->sh_name);
 		cleanup: sparseset_discard(&gs_assets.meta, ah_meta);
 	}
 	array_pop(&gs_assets.stack, 1);
 
+	array_free(&type->cache);
 	sparseset_free(&type->instances);
 	hashmap_del(&gs_assets.types, &sh_type);
 
 	if (inst_count > 0) { DEBUG_BREAK(); }
 }
 
+void system_assets_type_freeze(void) {
+	// @note: types are mostly registered once, then only looked up;
+	//        any later registration simply thaws the tables back
+	if (!hashmap_freeze(&gs_assets.types)) { WRN("can't freeze types"); }
+	if (!hashmap_freeze(&gs_assets.map))   { WRN("can't freeze map"); }
+}
+
+void system_assets_type_budget(struct CString type_name, uint64_t budget) {
+	struct Handle const sh_type = system_strings_find(type_name);
+	struct Asset_Type * type = hashmap_handle_asset_type_get(&gs_assets.types, &sh_type);
+	if (type == NULL) { return; }
+
+	type->info.budget = budget;
+	system_assets_trim(type);
+}
+
+void system_assets_flush(void) {
+	// @note: evictions drop dependencies, which might get cached in turn
+	for (bool evicted = true; evicted; /*empty*/) {
+		evicted = false;
+		FOR_HASHMAP(&gs_assets.types, it) {
+			struct Asset_Type * type = it.value;
+			while (type->cache.count > 0) {
+				system_assets_evict(type);
+				evicted = true;
+			}
+		}
+	}
+}
+
+struct Asset_Cache_Stats system_assets_get_cache_stats(struct CString type_name) {
+	struct Handle const sh_type = system_strings_find(type_name);
+	struct Asset_Type const * type = hashmap_handle_asset_type_get(&gs_assets.types, &sh_type);
+	return (type != NULL) ? type->cache_stats : (struct Asset_Cache_Stats){0};
+}
+
 struct Handle system_assets_load(struct CString name) {
+	return system_assets_load_internal(name, false);
+}
+
+struct Handle system_assets_load_async(struct CString name) {
+	return system_assets_load_internal(name, true);
+}
+
+bool system_assets_is_pending(struct Handle handle) {
+	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
+	return (meta != NULL) && (meta->async != NULL);
+}
+
+void system_assets_wait(struct Handle handle) {
+	if (!system_assets_is_pending(handle)) { return; }
+	system_assets_finalize(handle);
+}
+
+void system_assets_sync(void) {
+	// @note: nested loads might finalize and remove other entries;
+	//        the skipped ones are picked up by the next sync
+	for (uint32_t i = 0; i < gs_assets.pending.count; /*empty*/) {
+		struct Handle const handle = *(struct Handle *)array_at(&gs_assets.pending, i);
+		struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
+		if (!system_jobs_is_done(&meta->async->group)) { i++; continue; }
+		system_assets_finalize(handle);
+	}
+
+	FOR_HASHMAP(&gs_assets.types, it) {
+		struct Asset_Type * type = it.value;
+		system_assets_trim(type);
+	}
+}
+
+void * system_assets_get_staged(struct Handle handle) {
+	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
+	return (meta != NULL) ? meta->staged : NULL;
+}
+
+HANDLE_ACTION(system_assets_drop) {
+	struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, handle);
+	if (meta == NULL) { return; }
+	if (meta->cached) { WRN("unreferenced asset"); DEBUG_BREAK(); return; }
+	if (meta->ref_count > 0) {
+		system_assets_report(S_("[unrf]"), handle);
+		meta->ref_count--; return;
+	}
+
+	// @note: the staged data is owned by `load`
+	if (meta->async != NULL) {
+		system_assets_finalize(handle);
+		meta = sparseset_get(&gs_assets.meta, handle);
+	}
+
+	struct Asset_Type * type = hashmap_handle_asset_type_get(&gs_assets.types, &meta->sh_type);
+	// @note: trimmed at the sync point, so that GPU objects outlive the frame
+	if (type != NULL && type->info.budget > 0) {
+		system_assets_cache(type, handle);
+		return;
+	}
+
+	system_assets_destroy(handle);
+}
+
+void * system_assets_get(struct Handle handle) {
+	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
+	if (meta == NULL) { return NULL; }
+	if (meta->async != NULL) { return NULL; }
+
+	struct Asset_Type * type = hashmap_handle_asset_type_get(&gs_assets.types, &meta->sh_type);
+	struct Asset_Inst * inst = (type != NULL)
+		? sparseset_get(&type->instances, meta->inst_handle)
+		: NULL;
+	return (inst != NULL) ? inst->payload : NULL;
+}
+
+struct Handle system_assets_find(struct CString name) {
 	struct Handle const sh_name = system_strings_add(name);
 	if (handle_is_null(sh_name)) { return (struct Handle){0}; }
+	struct Handle const * ah_meta = hashmap_handle_handle_get(&gs_assets.handles, &sh_name);
+	return (ah_meta != NULL) ? *ah_meta : (struct Handle){0};
+}
 
-	struct Handle const * ah_meta = hashmap_get(&gs_assets.handles, &sh_name);
-	if (ah_meta != NULL) {
-		system_assets_add_dependency(*ah_meta);
-		struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, *ah_meta);
-		meta->ref_count++; system_assets_report(S_("[refc]"), *ah_meta);
-		return *ah_meta;
-	}
+struct CString system_assets_get_type(struct Handle handle) {
+	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
+	if (meta == NULL) { return (struct CString){0}; }
+	return system_strings_get(meta->sh_type);
+}
 
-	//
-	struct CString const extension = system_assets_name_to_extension(name);
-	struct Handle const sh_extension = system_strings_find(extension);
-	if (handle_is_null(sh_extension)) { return (struct Handle){0}; }
+struct Asset_Info const * system_assets_get_info(struct CString name) {
+	struct Handle sh_type;
+	struct Asset_Type const * type = system_assets_name_to_type(name, &sh_type);
+	return (type != NULL) ? &type->info : NULL;
+}
+
+struct CString system_assets_get_name(struct Handle handle) {
+	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
+	if (meta == NULL) { return (struct CString){0}; }
+	return system_strings_get(meta->sh_name);
+}
+
+//
+
+static struct Handle system_assets_load_internal(struct CString name, bool async) {
+	struct Handle const sh_name = system_strings_add(name);
+	if (handle_is_null(sh_name)) { return (struct Handle){0}; }
 
-	struct Handle const * sh_type_ptr = hashmap_get(&gs_assets.map, &sh_extension);
-	struct Handle const sh_type = (sh_type_ptr != NULL) ? *sh_type_ptr : sh_extension;
+	struct Handle const * ah_meta_ptr = hashmap_handle_handle_get(&gs_assets.handles, &sh_name);
+	if (ah_meta_ptr != NULL) {
+		struct Handle const ah_meta = *ah_meta_ptr;
+		system_assets_add_dependency(ah_meta);
+		struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, ah_meta);
+		if (meta->cached) {
+			struct Asset_Type * type = hashmap_handle_asset_type_get(&gs_assets.types, &meta->sh_type);
+			system_assets_uncache(type, ah_meta);
+			type->cache_stats.hits++;
+			system_assets_report(S_("[hit ]"), ah_meta);
+			return ah_meta;
+		}
+		meta->ref_count++; system_assets_report(S_("[refc]"), ah_meta);
+		if (!async) { system_assets_wait(ah_meta); }
+		return ah_meta;
+	}
 
 	//
-	struct Asset_Type * type = hashmap_get(&gs_assets.types, &sh_type);
+	struct Handle sh_type;
+	struct Asset_Type * type = system_assets_name_to_type(name, &sh_type);
 	if (type == NULL) { return (struct Handle){0}; }
+	type->cache_stats.misses++;
 
 	//
 	struct Handle const inst_handle = sparseset_aquire(&type->instances, NULL);
 	struct Handle const ah_meta_new = sparseset_aquire(&gs_assets.meta, &(struct Asset_Meta){
-		.dependencies = array_init(sizeof(struct Handle)),
+		.dependencies = {
+			.context = system_memory_heap_get_context(gs_assets.heap),
+			.value_size = sizeof(struct Handle),
+		},
 		.inst_handle = inst_handle,
 		.sh_type = sh_type,
 		.sh_name = sh_name,
 	});
-	hashmap_set(&gs_assets.handles, &sh_name, &ah_meta_new);
+	hashmap_handle_handle_set(&gs_assets.handles, &sh_name, &ah_meta_new);
 	system_assets_add_dependency(ah_meta_new);
 
 	struct Asset_Inst * inst = sparseset_get(&type->instances, inst_handle);
@@ -201,25 +394,82 @@ struct Handle system_assets_load(struct CString name) {
 		.ah_meta = ah_meta_new,
 	};
 
-	system_assets_report(S_("[load]"), ah_meta_new);
-	array_push_many(&gs_assets.stack, 1, &ah_meta_new);
+	if (async && type->info.prepare != NULL) {
+		struct Allocator_Context * context = system_memory_heap_get_context(gs_assets.heap);
+		struct Asset_Async * asset_async = realloc_context(NULL, context, NULL, sizeof(*asset_async) + name.length + 1);
+		char * name_data = (char *)(asset_async + 1);
+		common_memcpy(name_data, name.data, name.length);
+		name_data[name.length] = '\0';
+		*asset_async = (struct Asset_Async){
+			.prepare = type->info.prepare,
+			.name = {
+				.length = name.length,
+				.data = name_data,
+			},
+		};
+
+		struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, ah_meta_new);
+		meta->async = asset_async;
+		array_push_many(&gs_assets.pending, 1, &ah_meta_new);
+
+		system_assets_report(S_("[asnc]"), ah_meta_new);
+		system_jobs_push(system_assets_prepare_job, asset_async, &asset_async->group);
+		return ah_meta_new;
+	}
+
+	void * staged = (type->info.prepare != NULL)
+		? type->info.prepare(system_strings_get(sh_name))
+		: NULL;
+	system_assets_invoke_load(type, ah_meta_new, staged);
+
+	return ah_meta_new;
+}
+
+static void system_assets_invoke_load(struct Asset_Type const * type, struct Handle handle, void * staged) {
+	struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, handle);
+	meta->staged = staged;
+
+	system_assets_report(S_("[load]"), handle);
+	array_push_many(&gs_assets.stack, 1, &handle);
 	if (type->info.load != NULL) {
-		type->info.load(ah_meta_new);
+		type->info.load(handle);
 	}
 	array_pop(&gs_assets.stack, 1);
 
-	return ah_meta_new;
+	meta = sparseset_get(&gs_assets.meta, handle);
+	meta->staged = NULL;
 }
 
-HANDLE_ACTION(system_assets_drop) {
+static HANDLE_ACTION(system_assets_finalize) {
 	struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, handle);
-	if (meta == NULL) { return; }
-	if (meta->ref_count > 0) {
-		system_assets_report(S_("[unrf]"), handle);
-		meta->ref_count--; return;
+	struct Asset_Async * asset_async = meta->async;
+	system_jobs_wait(&asset_async->group);
+
+	void * staged = asset_async->staged;
+	meta->async = NULL;
+	realloc_context(NULL, system_memory_heap_get_context(gs_assets.heap), asset_async, 0);
+
+	FOR_ARRAY(&gs_assets.pending, it) {
+		struct Handle const * ah_meta = it.value;
+		if (!handle_equals(*ah_meta, handle)) { continue; }
+		array_remove_many(&gs_assets.pending, it.curr, 1);
+		break;
+	}
+
+	struct Asset_Type const * type = hashmap_handle_asset_type_get(&gs_assets.types, &meta->sh_type);
+	system_assets_invoke_load(type, handle, staged);
+}
+
+static void system_assets_wait_all(void) {
+	while (gs_assets.pending.count > 0) {
+		struct Handle const * handle = array_at(&gs_assets.pending, 0);
+		system_assets_finalize(*handle);
 	}
+}
 
-	struct Asset_Type * type = hashmap_get(&gs_assets.types, &meta->sh_type);
+static HANDLE_ACTION(system_assets_destroy) {
+	struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, handle);
+	struct Asset_Type * type = hashmap_handle_asset_type_get(&gs_assets.types, &meta->sh_type);
 	if (type == NULL) { WRN("meta w/o type"); DEBUG_BREAK(); goto cleanup; }
 
 	struct Asset_Inst * inst = sparseset_get(&type->instances, meta->inst_handle);
@@ -235,55 +485,69 @@ HANDLE_ACTION(system_assets_drop) {
 
 	cleanup:
 	array_push_many(&gs_assets.stack, 1, &handle);
-	FOR_ARRAY(&meta->dependencies, it) {
+	FOR_SMALLARRAY(&meta->dependencies, it) {
 		struct Handle const * ah_meta_child = it.value;
 		system_assets_drop(*ah_meta_child);
 	}
 	array_pop(&gs_assets.stack, 1);
-	array_free(&meta->dependencies);
+	smallarray_free(&meta->dependencies);
 
 	hashmap_del(&gs_assets.handles, &meta->sh_name);
 	sparseset_discard(&gs_assets.meta, handle);
 }
 
-void * system_assets_get(struct Handle handle) {
-	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
-	if (meta == NULL) { return NULL; }
-
-	struct Asset_Type * type = hashmap_get(&gs_assets.types, &meta->sh_type);
-	struct Asset_Inst * inst = (type != NULL)
-		? sparseset_get(&type->instances, meta->inst_handle)
-		: NULL;
-	return (inst != NULL) ? inst->payload : NULL;
+static void system_assets_cache(struct Asset_Type * type, struct Handle handle) {
+	struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, handle);
+	meta->cached = true;
+	meta->cached_size = (type->info.measure != NULL)
+		? type->info.measure(handle)
+		: type->info.size;
+	array_push_many(&type->cache, 1, &handle);
+	type->cache_stats.count++;
+	type->cache_stats.bytes += meta->cached_size;
+	system_assets_report(S_("[cach]"), handle);
 }
 
-struct Handle system_assets_find(struct CString name) {
-	struct Handle const sh_name = system_strings_add(name);
-	if (handle_is_null(sh_name)) { return (struct Handle){0}; }
-	struct Handle const * ah_meta = hashmap_get(&gs_assets.handles, &sh_name);
-	return (ah_meta != NULL) ? *ah_meta : (struct Handle){0};
+static void system_assets_uncache(struct Asset_Type * type, struct Handle handle) {
+	struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, handle);
+	FOR_ARRAY(&type->cache, it) {
+		struct Handle const * ah_meta = it.value;
+		if (!handle_equals(*ah_meta, handle)) { continue; }
+		array_remove_many(&type->cache, it.curr, 1);
+		break;
+	}
+	type->cache_stats.count--;
+	type->cache_stats.bytes -= meta->cached_size;
+	meta->cached_size = 0;
+	meta->cached = false;
 }
 
-struct CString system_assets_get_type(struct Handle handle) {
-	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
-	if (meta == NULL) { return (struct CString){0}; }
-	return system_strings_get(meta->sh_type);
+static void system_assets_evict(struct Asset_Type * type) {
+	struct Handle const handle = *(struct Handle *)array_at(&type->cache, 0);
+	system_assets_uncache(type, handle);
+	type->cache_stats.evictions++;
+	system_assets_report(S_("[evct]"), handle);
+	system_assets_destroy(handle);
 }
 
-struct CString system_assets_get_name(struct Handle handle) {
-	struct Asset_Meta const * meta = sparseset_get(&gs_assets.meta, handle);
-	if (meta == NULL) { return (struct CString){0}; }
-	return system_strings_get(meta->sh_name);
+static void system_assets_trim(struct Asset_Type * type) {
+	while (type->cache.count > 0) {
+		if (type->info.budget > 0 && type->cache_stats.bytes <= type->info.budget) { break; }
+		system_assets_evict(type);
+	}
 }
 
-//
+static THREAD_PROC(system_assets_prepare_job) {
+	struct Asset_Async * asset_async = data;
+	asset_async->staged = asset_async->prepare(asset_async->name);
+}
 
 static HANDLE_ACTION(system_assets_add_dependency) {
 	if (gs_assets.stack.count == 0) { return; }
 	struct Handle const * ah_meta_parent = array_peek(&gs_assets.stack, 0);
 	struct Asset_Meta * meta = sparseset_get(&gs_assets.meta, *ah_meta_parent);
 	if (meta == NULL) { return; }
-	array_push_many(&meta->dependencies, 1, &handle);
+	smallarray_push_many(&meta->dependencies, 1, &handle);
 }
 
 static void system_assets_report(struct CString tag, struct Handle handle) {
@@ -294,11 +558,21 @@ static void system_assets_report(struct CString tag, struct Handle handle) {
 		, indent, ""
 		, tag.length, tag.data
 		, (uint32_t)handle.id, (uint32_t)handle.gen
-		, meta->ref_count + 1
+		, meta->ref_count + (meta->cached ? 0 : 1)
 		, name.length, name.data
 	);
 }
 
+static struct Asset_Type * system_assets_name_to_type(struct CString name, struct Handle * sh_type) {
+	struct CString const extension = system_assets_name_to_extension(name);
+	struct Handle const sh_extension = system_strings_find(extension);
+	if (handle_is_null(sh_extension)) { return NULL; }
+
+	struct Handle const * sh_type_ptr = hashmap_handle_handle_get(&gs_assets.map, &sh_extension);
+	*sh_type = (sh_type_ptr != NULL) ? *sh_type_ptr : sh_extension;
+	return hashmap_handle_asset_type_get(&gs_assets.types, sh_type);
+}
+
 static struct CString system_assets_name_to_extension(struct CString name) {
 	for (uint32_t extension_length = 0; extension_length < name.length; extension_length++) {
 		// @todo: make it unicode-aware?
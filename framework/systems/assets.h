@@ -3,10 +3,32 @@
 
 #include "framework/common.h"
 
+// @note: runs off the main thread for asynchronous loads, thus should touch
+//        neither assets nor strings; the result is handed over to `load`
+#define ASSET_PREPARE(func) void * (func)(struct CString name)
+typedef ASSET_PREPARE(Asset_Prepare);
+
+// @note: bytes an asset holds, including its GPU objects
+#define ASSET_MEASURE(func) uint64_t (func)(struct Handle handle)
+typedef ASSET_MEASURE(Asset_Measure);
+
+// @note: unreferenced assets stay resident; the least recently dropped are evicted
+//        at the sync point while their measured bytes exceed the `budget`;
+//        zero drops them at once
 struct Asset_Info {
 	uint32_t size;
+	uint64_t budget;
+	Asset_Prepare * prepare; // optional, expects `load`
 	Handle_Action * load;
 	Handle_Action * drop;
+	Asset_Measure * measure; // optional, `size` otherwise
+};
+
+// @note: counted since the type was set; a hit revives an unreferenced asset,
+//        a miss loads one anew
+struct Asset_Cache_Stats {
+	uint64_t hits, misses, evictions; // calls
+	uint64_t count, bytes;            // unreferenced, resident
 };
 
 void system_assets_init(void);
@@ -15,13 +37,32 @@ void system_assets_free(void);
 void system_assets_type_map(struct CString type_name, struct CString extension);
 void system_assets_type_set(struct CString type_name, struct Asset_Info info);
 void system_assets_type_del(struct CString type_name);
+void system_assets_type_freeze(void);
+void system_assets_type_budget(struct CString type_name, uint64_t budget);
+
+// @note: evicts every unreferenced asset
+void system_assets_flush(void);
+struct Asset_Cache_Stats system_assets_get_cache_stats(struct CString type_name);
 
 struct Handle system_assets_load(struct CString name);
 HANDLE_ACTION(system_assets_drop);
 
+// @note: prepares on a worker, then loads at a sync point; meanwhile the asset
+//        is pending and `system_assets_get` yields `NULL`
+struct Handle system_assets_load_async(struct CString name);
+bool system_assets_is_pending(struct Handle handle);
+void system_assets_wait(struct Handle handle);
+void system_assets_sync(void); // expects the GPU context
+
+// @note: the result of `prepare`, valid during `load`; ownership is transferred
+void * system_assets_get_staged(struct Handle handle);
+
 void * system_assets_get(struct Handle handle);
 struct Handle system_assets_find(struct CString name);
 struct CString system_assets_get_type(struct Handle handle);
 struct CString system_assets_get_name(struct Handle handle);
 
+// @note: of the type an asset name maps to, if any
+struct Asset_Info const * system_assets_get_info(struct CString name);
+
 #endif
@@ -0,0 +1,131 @@
+#include "framework/maths.h"
+#include "framework/containers/array.h"
+#include "framework/systems/memory.h"
+
+
+//
+#include "jobs.h"
+
+// @note: each worker claims an arena of its own
+#define SYSTEM_JOBS_THREADS 8
+
+struct Job {
+	Thread_Proc * proc;
+	void * data;
+	struct Jobs_Group * group;
+};
+
+static struct Jobs {
+	struct Platform_Lock lock;
+	struct Platform_Condition wake; // workers
+	struct Platform_Condition done; // waiters
+	struct Array queue; // `struct Job`
+	uint32_t head;
+	bool stop;
+	uint32_t threads_count;
+	void * threads[SYSTEM_JOBS_THREADS];
+} gs_jobs;
+
+// @note: expects the lock
+static bool system_jobs_pop(struct Job * job) {
+	if (gs_jobs.head >= gs_jobs.queue.count) { return false; }
+	*job = *(struct Job *)array_at(&gs_jobs.queue, gs_jobs.head++);
+	if (gs_jobs.head == gs_jobs.queue.count) {
+		gs_jobs.queue.count = 0;
+		gs_jobs.head = 0;
+	}
+	return true;
+}
+
+// @note: expects the lock, releases it while running
+static void system_jobs_run(struct Job job) {
+	platform_lock_release(&gs_jobs.lock);
+
+	struct Memory_Arena_Mark const mark = system_memory_arena_mark();
+	job.proc(job.data);
+	system_memory_arena_rewind(mark);
+
+	platform_lock_acquire(&gs_jobs.lock);
+	if (job.group != NULL) {
+		job.group->pending--;
+		if (job.group->pending == 0) {
+			platform_condition_broadcast(&gs_jobs.done);
+		}
+	}
+}
+
+static THREAD_PROC(system_jobs_worker) {
+	(void)data;
+	platform_lock_acquire(&gs_jobs.lock);
+	for (;;) {
+		struct Job job;
+		if (system_jobs_pop(&job)) { system_jobs_run(job); continue; }
+		if (gs_jobs.stop) { break; }
+		platform_condition_wait(&gs_jobs.wake, &gs_jobs.lock);
+	}
+	platform_lock_release(&gs_jobs.lock);
+	system_memory_arena_detach();
+}
+
+void system_jobs_init(uint32_t threads_count) {
+	if (threads_count == 0) {
+		uint32_t const cores = platform_thread_get_cores();
+		threads_count = cores > 1 ? cores - 1 : 1;
+	}
+	threads_count = min_u32(threads_count, SYSTEM_JOBS_THREADS);
+
+	gs_jobs = (struct Jobs){
+		.queue = array_init(sizeof(struct Job)),
+		.threads_count = threads_count,
+	};
+	array_resize(&gs_jobs.queue, 64);
+
+	for (uint32_t i = 0; i < gs_jobs.threads_count; i++) {
+		gs_jobs.threads[i] = platform_thread_start(system_jobs_worker, NULL);
+	}
+}
+
+void system_jobs_free(void) {
+	platform_lock_acquire(&gs_jobs.lock);
+	gs_jobs.stop = true;
+	platform_condition_broadcast(&gs_jobs.wake);
+	platform_lock_release(&gs_jobs.lock);
+
+	for (uint32_t i = 0; i < gs_jobs.threads_count; i++) {
+		platform_thread_join(gs_jobs.threads[i]);
+	}
+
+	array_free(&gs_jobs.queue);
+	cbuffer_clear(CBM_(gs_jobs));
+}
+
+void system_jobs_push(Thread_Proc * proc, void * data, struct Jobs_Group * group) {
+	platform_lock_acquire(&gs_jobs.lock);
+	array_push_many(&gs_jobs.queue, 1, &(struct Job){
+		.proc = proc,
+		.data = data,
+		.group = group,
+	});
+	if (group != NULL) { group->pending++; }
+	platform_condition_signal(&gs_jobs.wake);
+	platform_lock_release(&gs_jobs.lock);
+}
+
+bool system_jobs_is_done(struct Jobs_Group * group) {
+	platform_lock_acquire(&gs_jobs.lock);
+	bool const done = (group->pending == 0);
+	platform_lock_release(&gs_jobs.lock);
+	return done;
+}
+
+void system_jobs_wait(struct Jobs_Group * group) {
+	platform_lock_acquire(&gs_jobs.lock);
+	while (group->pending > 0) {
+		struct Job job;
+		if (system_jobs_pop(&job)) { system_jobs_run(job); continue; }
+		platform_condition_wait(&gs_jobs.done, &gs_jobs.lock);
+	}
+	platform_lock_release(&gs_jobs.lock);
+}
+
+#undef SYSTEM_JOBS_THREADS
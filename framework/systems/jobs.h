@@ -0,0 +1,22 @@
+#if !defined(FRAMEWORK_SYSTEMS_JOBS)
+#define FRAMEWORK_SYSTEMS_JOBS
+
+#include "framework/platform/thread.h"
+
+// @note: counts jobs in flight; zero initialized is done
+struct Jobs_Group {
+	uint32_t pending;
+};
+
+// @note: `0` threads stand for one less than the cores
+void system_jobs_init(uint32_t threads_count);
+void system_jobs_free(void); // runs the queue out
+
+// @note: `group` is optional; jobs are free to use the arena,
+//        it is rewound after each of them
+void system_jobs_push(Thread_Proc * proc, void * data, struct Jobs_Group * group);
+
+bool system_jobs_is_done(struct Jobs_Group * group);
+void system_jobs_wait(struct Jobs_Group * group); // runs queued jobs meanwhile
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "framework/platform/allocator.h"
 #include "framework/platform/debug.h"
+#include "framework/platform/memory.h"
+#include "framework/platform/thread.h"
 
 #include "framework/containers/array.h"
 #include "framework/containers/buffer.h"
@@ -12,6 +14,188 @@
 //
 #include "memory.h"
 
+// ----- ----- ----- ----- -----
+//     Telemetry part
+// ----- ----- ----- ----- -----
+
+#define SYSTEM_MEMORY_TAGS 32
+
+static struct System_Memory_Telemetry {
+	struct Memory_Telemetry types[MEMORY_TYPE_COUNT];
+	struct Platform_Lock tags_lock;
+	uint32_t tags_count;
+	struct Memory_Tag {
+		struct CString name;
+		struct Memory_Telemetry telemetry;
+	} tags[SYSTEM_MEMORY_TAGS];
+} gs_system_memory_telemetry;
+
+static void system_memory_heap_dump(struct Buffer * buffer, uint64_t frame);
+
+static THREAD_LOCAL struct Memory_Watch_Local {
+	bool active;
+	uint32_t count;
+} gs_system_memory_watch_local;
+
+static void system_memory_watch_check(void const * pointer, size_t size) {
+	struct Memory_Watch_Local * local = &gs_system_memory_watch_local;
+	if (!local->active) { return; }
+	if (size == 0) { return; }
+
+	local->count++;
+
+	// @note: reporting might allocate on its own
+	local->active = false;
+	WRN("heap %s of %zu bytes while watched:", (pointer != NULL) ? "reallocation" : "allocation", size);
+	REPORT_CALLSTACK();
+	local->active = true;
+}
+
+static void system_memory_telemetry_live(struct Memory_Telemetry * telemetry, size_t size_old, size_t size_new) {
+	if (size_new == size_old) { return; }
+	uint64_t const delta = (uint64_t)size_new - (uint64_t)size_old;
+	uint64_t const live = platform_atomic_add_u64(&telemetry->live, delta) + delta;
+	if (size_new > size_old) { platform_atomic_max_u64(&telemetry->peak, live); }
+}
+
+static void system_memory_telemetry_calls(struct Memory_Telemetry * telemetry, void const * pointer, size_t size_old, size_t size, void const * result) {
+	if (pointer == NULL && size == 0) { return; }
+	if (pointer == NULL) { platform_atomic_add_u64(&telemetry->allocate, 1); return; }
+	if (size == 0)       { platform_atomic_add_u64(&telemetry->free,     1); return; }
+
+	platform_atomic_add_u64(&telemetry->reallocate, 1);
+	if (result != pointer) { platform_atomic_add_u64(&telemetry->copied, min_size(size_old, size)); }
+}
+
+// @note: expects a successful call
+static void system_memory_telemetry_track(struct Memory_Telemetry * telemetry, void const * pointer, size_t size_old, size_t size, void const * result) {
+	system_memory_telemetry_calls(telemetry, pointer, size_old, size, result);
+	system_memory_telemetry_live(telemetry, size_old, size);
+}
+
+struct Memory_Telemetry system_memory_get_telemetry(enum Memory_Type type) {
+	if (type == MEMORY_TYPE_PLATFORM) {
+		struct Platform_Allocator_Stats const stats = platform_allocator_get_stats();
+		return (struct Memory_Telemetry){
+			.allocate   = stats.allocate,
+			.reallocate = stats.reallocate,
+			.free       = stats.free,
+			.copied     = stats.copied,
+			.live       = stats.live,
+			.peak       = stats.peak,
+		};
+	}
+	if (type < MEMORY_TYPE_COUNT) { return gs_system_memory_telemetry.types[type]; }
+	return (struct Memory_Telemetry){0};
+}
+
+uint32_t system_memory_tag_register(struct CString name) {
+	platform_lock_acquire(&gs_system_memory_telemetry.tags_lock);
+
+	uint32_t tag_id = 0;
+	for (uint32_t i = 0; i < gs_system_memory_telemetry.tags_count; i++) {
+		if (cstring_equals(gs_system_memory_telemetry.tags[i].name, name)) { tag_id = i + 1; break; }
+	}
+
+	if (tag_id == 0 && gs_system_memory_telemetry.tags_count < SYSTEM_MEMORY_TAGS) {
+		uint32_t const index = gs_system_memory_telemetry.tags_count++;
+		gs_system_memory_telemetry.tags[index].name = name;
+		tag_id = index + 1;
+	}
+
+	platform_lock_release(&gs_system_memory_telemetry.tags_lock);
+
+	if (tag_id == 0) {
+		ERR("memory tags are exhausted: \"%.*s\"", name.length, name.data);
+		REPORT_CALLSTACK(); DEBUG_BREAK();
+	}
+	return tag_id;
+}
+
+struct Memory_Telemetry system_memory_get_tag_telemetry(uint32_t tag_id) {
+	if (tag_id == 0 || tag_id > SYSTEM_MEMORY_TAGS) { return (struct Memory_Telemetry){0}; }
+	return gs_system_memory_telemetry.tags[tag_id - 1].telemetry;
+}
+
+void * system_memory_tag_reallocate(uint32_t tag_id, Allocator * allocate, void * pointer, size_t size) {
+	// @note: allocators of this file keep the size right before the data
+	size_t const size_old = (pointer != NULL)
+		? ((struct Memory_Header *)pointer - 1)->size
+		: 0;
+
+	void * const result = allocate(pointer, size);
+	if (result == NULL && size != 0) { return NULL; }
+
+	if (tag_id != 0 && tag_id <= SYSTEM_MEMORY_TAGS) {
+		struct Memory_Telemetry * telemetry = &gs_system_memory_telemetry.tags[tag_id - 1].telemetry;
+		system_memory_telemetry_track(telemetry, pointer, size_old, size, result);
+	}
+	return result;
+}
+
+void system_memory_watch_begin(void) {
+	gs_system_memory_watch_local = (struct Memory_Watch_Local){
+		.active = true,
+	};
+}
+
+uint32_t system_memory_watch_end(void) {
+	uint32_t const count = gs_system_memory_watch_local.count;
+	gs_system_memory_watch_local = (struct Memory_Watch_Local){0};
+	return count;
+}
+
+static void system_memory_telemetry_dump_row(struct Buffer * buffer, uint64_t frame, struct CString prefix, struct CString name, struct Memory_Telemetry telemetry) {
+	buffer_ensure(buffer, buffer->size + prefix.length + name.length + 7 * 21); // `UINT64_MAX` and `,` or `\n` per column
+	buffer->size += formatter_fmt(
+		buffer->capacity - buffer->size, buffer_at_unsafe(buffer, buffer->size),
+		"%llu,%.*s%.*s,%llu,%llu,%llu,%llu,%llu,%llu\n"
+		, (unsigned long long)frame
+		, prefix.length, prefix.data
+		, name.length, name.data
+		, (unsigned long long)telemetry.allocate
+		, (unsigned long long)telemetry.reallocate
+		, (unsigned long long)telemetry.free
+		, (unsigned long long)telemetry.copied
+		, (unsigned long long)telemetry.live
+		, (unsigned long long)telemetry.peak
+	);
+}
+
+void system_memory_telemetry_dump_header(struct Buffer * buffer) {
+	struct CString const header = S_("frame,source,allocate,reallocate,free,copied,live,peak\n");
+	buffer_push_many(buffer, header.length, header.data);
+}
+
+void system_memory_telemetry_dump(struct Buffer * buffer, uint64_t frame) {
+	static struct CString const c_type_names[] = {
+		[MEMORY_TYPE_PLATFORM] = S__("platform"),
+		[MEMORY_TYPE_GENERIC]  = S__("generic"),
+		[MEMORY_TYPE_DEBUG]    = S__("debug"),
+		[MEMORY_TYPE_POOL]     = S__("pool"),
+		[MEMORY_TYPE_ARENA]    = S__("arena"),
+		[MEMORY_TYPE_FRAME]    = S__("frame"),
+	};
+
+	for (enum Memory_Type type = 0; type < MEMORY_TYPE_COUNT; type++) {
+		struct Memory_Telemetry const telemetry = system_memory_get_telemetry(type);
+		system_memory_telemetry_dump_row(buffer, frame, S_(""), c_type_names[type], telemetry);
+	}
+
+	platform_lock_acquire(&gs_system_memory_telemetry.tags_lock);
+	uint32_t const tags_count = gs_system_memory_telemetry.tags_count;
+	platform_lock_release(&gs_system_memory_telemetry.tags_lock);
+
+	for (uint32_t i = 0; i < tags_count; i++) {
+		struct Memory_Tag const * tag = gs_system_memory_telemetry.tags + i;
+		system_memory_telemetry_dump_row(buffer, frame, S_("tag:"), tag->name, tag->telemetry);
+	}
+
+	system_memory_heap_dump(buffer, frame);
+}
+
+#undef SYSTEM_MEMORY_TAGS
+
 // ----- ----- ----- ----- -----
 //     Generic part
 // ----- ----- ----- ----- -----
@@ -21,6 +205,8 @@ inline static size_t system_memory_generic_checksum(void const * pointer) {
 }
 
 ALLOCATOR(realloc_generic) {
+	system_memory_watch_check(pointer, size);
+
 	struct Memory_Header * header = (pointer != NULL)
 		? (struct Memory_Header *)pointer - 1
 		: NULL;
@@ -34,6 +220,9 @@ ALLOCATOR(realloc_generic) {
 		header->checksum = 0;
 	}
 
+	struct Memory_Telemetry * telemetry = gs_system_memory_telemetry.types + MEMORY_TYPE_GENERIC;
+	size_t const size_old = (header != NULL) ? header->size : 0;
+
 	header = platform_reallocate(header, (size != 0)
 		? sizeof(*header) + size
 		: 0
@@ -45,9 +234,11 @@ ALLOCATOR(realloc_generic) {
 			.size = size,
 		};
 
+		system_memory_telemetry_track(telemetry, pointer, size_old, size, header + 1);
 		return header + 1;
 	}
 
+	if (size == 0) { system_memory_telemetry_track(telemetry, pointer, size_old, 0, NULL); }
 	return NULL;
 }
 
@@ -55,28 +246,149 @@ ALLOCATOR(realloc_generic) {
 //     Debug part
 // ----- ----- ----- ----- -----
 
-static struct Memory_Header_Debug {
+// @note: threads are spread over shards, each with its own list and lock;
+// a block remembers its shard, thus can be freed from any thread
+#define SYSTEM_MEMORY_DEBUG_SHARDS 8
+
+struct Memory_Header_Debug {
 	struct Memory_Header_Debug * prev;
 	struct Memory_Header_Debug * next;
-	struct Callstack callstack;
+	uint32_t shard;
+	uint32_t site;   // `index + 1` of a sampled one, or `0`
+	size_t weight;   // bytes it stands for, if sampled
 	struct Memory_Header base;
-} * gs_memory;
+};
+
+struct Memory_Debug_Site {
+	struct Callstack callstack;
+	uint32_t live_count, total_count; // samples
+	size_t live_bytes, peak_bytes, total_bytes;
+};
+
+static struct System_Memory_Debug {
+	struct Memory_Debug_Shard {
+		struct Platform_Lock lock;
+		struct Memory_Header_Debug * list;
+	} shards[SYSTEM_MEMORY_DEBUG_SHARDS];
+	uint32_t shards_next;
+	struct Memory_Debug_Sampling sampling;
+	// profile
+	struct Platform_Lock sites_lock;
+	struct Hashmap sites_index; // `struct Callstack` : `uint32_t`
+	struct Array sites;         // `struct Memory_Debug_Site`
+} gs_system_memory_debug;
+
+static THREAD_LOCAL struct Memory_Debug_Local {
+	uint32_t shard; // `shard + 1`, or `0`
+	uint32_t count;
+	size_t bytes;
+} gs_system_memory_debug_local;
 
 inline static size_t system_memory_debug_checksum(void const * pointer) {
 	return ~(size_t)pointer;
 }
 
-static void system_memory_debug_report(void) {
-	if (gs_memory == NULL) { return; }
+static HASHER(system_memory_debug_hash_callstack) {
+	struct Callstack const * callstack = value;
+	// kinda FNV-1
+	uint32_t const prime =   16777619u;
+	uint32_t       hash  = 2166136261u;
+	for (uint32_t i = 0; i < SIZE_OF_ARRAY(callstack->data) && callstack->data[i] != 0; i++) {
+		hash = (hash * prime) ^ (uint32_t)(callstack->data[i]);
+		hash = (hash * prime) ^ (uint32_t)(callstack->data[i] >> 32);
+	}
+	return hash;
+}
+
+static uint32_t system_memory_debug_get_shard(void) {
+	struct Memory_Debug_Local * local = &gs_system_memory_debug_local;
+	if (local->shard == 0) {
+		uint32_t const index = platform_atomic_add_u32(&gs_system_memory_debug.shards_next, 1);
+		local->shard = (index % SYSTEM_MEMORY_DEBUG_SHARDS) + 1;
+	}
+	return local->shard - 1;
+}
 
+static size_t system_memory_debug_sample(size_t size) {
+	struct Memory_Debug_Sampling const sampling = gs_system_memory_debug.sampling;
+	struct Memory_Debug_Local * local = &gs_system_memory_debug_local;
+
+	size_t weight = 0;
+	if (sampling.period_count > 0) {
+		local->count++;
+		if (local->count >= sampling.period_count) {
+			local->count = 0;
+			weight = size * sampling.period_count;
+		}
+	}
+	if (sampling.period_bytes > 0) {
+		local->bytes += size;
+		if (local->bytes >= sampling.period_bytes) {
+			weight = max_size(weight, local->bytes);
+			local->bytes = 0;
+		}
+	}
+	return weight;
+}
+
+static uint32_t system_memory_debug_site_push(struct Callstack const * callstack, size_t weight) {
+	platform_lock_acquire(&gs_system_memory_debug.sites_lock);
+
+	uint32_t index;
+	uint32_t const * found = hashmap_get(&gs_system_memory_debug.sites_index, callstack);
+	if (found != NULL) { index = *found; }
+	else {
+		index = gs_system_memory_debug.sites.count;
+		array_push_many(&gs_system_memory_debug.sites, 1, &(struct Memory_Debug_Site){
+			.callstack = *callstack,
+		});
+		hashmap_set(&gs_system_memory_debug.sites_index, callstack, &index);
+	}
+
+	struct Memory_Debug_Site * site = array_at(&gs_system_memory_debug.sites, index);
+	site->live_count++;
+	site->total_count++;
+	site->live_bytes += weight;
+	site->total_bytes += weight;
+	site->peak_bytes = max_size(site->peak_bytes, site->live_bytes);
+
+	platform_lock_release(&gs_system_memory_debug.sites_lock);
+	return index + 1;
+}
+
+static void system_memory_debug_site_pop(struct Memory_Header_Debug const * header) {
+	if (header->site == 0) { return; }
+	platform_lock_acquire(&gs_system_memory_debug.sites_lock);
+
+	struct Memory_Debug_Site * site = array_at(&gs_system_memory_debug.sites, header->site - 1);
+	site->live_count--;
+	site->live_bytes -= header->weight;
+
+	platform_lock_release(&gs_system_memory_debug.sites_lock);
+}
+
+static void system_memory_debug_print_site(uint32_t padding, uint32_t site_id) {
+	if (site_id == 0) {
+		LOG("%*s", padding, "");
+		LOG("not sampled\n");
+		return;
+	}
+	struct Memory_Debug_Site const * site = array_at(&gs_system_memory_debug.sites, site_id - 1);
+	PRINT_CALLSTACK(padding, site->callstack); (void)site;
+}
+
+static void system_memory_debug_report(void) {
 	uint32_t const pointer_digits_count = sizeof(size_t) * 2;
 
 	uint32_t total_count = 0;
 	uint64_t total_bytes = 0;
-	for (struct Memory_Header_Debug * it = gs_memory; it; it = it->next) {
-		total_count++;
-		total_bytes += it->base.size;
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_DEBUG_SHARDS; i++) {
+		for (struct Memory_Header_Debug * it = gs_system_memory_debug.shards[i].list; it; it = it->next) {
+			total_count++;
+			total_bytes += it->base.size;
+		}
 	}
+	if (total_count == 0) { return; }
 
 	uint32_t bytes_digits_count = 0;
 	for (size_t v = total_bytes; v > 0; v = v / 10) {
@@ -95,20 +407,24 @@ static void system_memory_debug_report(void) {
 		);
 	}
 
-	for (struct Memory_Header_Debug const * it = gs_memory; it != NULL; it = it->next) {
-		WRN(
-			"  [%#.*zx] (bytes: %*zu) stacktrace:"
-			""
-			, pointer_digits_count, (size_t)(it + 1)
-			, bytes_digits_count,   it->base.size
-		);
-		PRINT_CALLSTACK(2, it->callstack);
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_DEBUG_SHARDS; i++) {
+		for (struct Memory_Header_Debug const * it = gs_system_memory_debug.shards[i].list; it != NULL; it = it->next) {
+			WRN(
+				"  [%#.*zx] (bytes: %*zu) stacktrace:"
+				""
+				, pointer_digits_count, (size_t)(it + 1)
+				, bytes_digits_count,   it->base.size
+			);
+			system_memory_debug_print_site(2, it->site);
+		}
 	}
 
 	DEBUG_BREAK();
 }
 
 ALLOCATOR(realloc_debug) {
+	system_memory_watch_check(pointer, size);
+
 	struct Memory_Header_Debug * header = (pointer != NULL)
 		? (struct Memory_Header_Debug *)pointer - 1
 		: NULL;
@@ -116,218 +432,1018 @@ ALLOCATOR(realloc_debug) {
 	if (header != NULL) {
 		if (header->base.checksum != system_memory_debug_checksum(header)) {
 			ERR("> debug memory:");
-			PRINT_CALLSTACK(2, header->callstack);
+			system_memory_debug_print_site(2, header->site);
 			REPORT_CALLSTACK(); DEBUG_BREAK();
 			return NULL;
 		}
 		header->base.checksum = 0;
 
-		if (gs_memory == header) { gs_memory = header->next; }
+		struct Memory_Debug_Shard * shard = gs_system_memory_debug.shards + header->shard;
+		platform_lock_acquire(&shard->lock);
+		if (shard->list == header) { shard->list = header->next; }
 		if (header->next != NULL) { header->next->prev = header->prev; }
 		if (header->prev != NULL) { header->prev->next = header->next; }
+		platform_lock_release(&shard->lock);
+
+		system_memory_debug_site_pop(header);
 	}
 
+	struct Memory_Telemetry * telemetry = gs_system_memory_telemetry.types + MEMORY_TYPE_DEBUG;
+	size_t const size_old = (header != NULL) ? header->base.size : 0;
+
 	header = platform_reallocate(header, (size != 0)
 		? sizeof(*header) + size
 		: 0
 	);
 
 	if (header != NULL) {
+		uint32_t const shard_index = system_memory_debug_get_shard();
 		*header = (struct Memory_Header_Debug){
 			.base = {
 				.checksum = system_memory_debug_checksum(header),
 				.size = size,
 			},
-			.callstack = platform_debug_get_callstack(1),
+			.shard = shard_index,
+			.weight = system_memory_debug_sample(size),
 		};
 
-		header->next = gs_memory;
-		if (gs_memory != NULL) { gs_memory->prev = header; }
-		gs_memory = header;
+		if (header->weight > 0) {
+			struct Callstack const callstack = platform_debug_get_callstack(1);
+			header->site = system_memory_debug_site_push(&callstack, header->weight);
+		}
+
+		struct Memory_Debug_Shard * shard = gs_system_memory_debug.shards + shard_index;
+		platform_lock_acquire(&shard->lock);
+		header->next = shard->list;
+		if (shard->list != NULL) { shard->list->prev = header; }
+		shard->list = header;
+		platform_lock_release(&shard->lock);
 
+		system_memory_telemetry_track(telemetry, pointer, size_old, size, header + 1);
 		return header + 1;
 	}
 
+	if (size == 0) { system_memory_telemetry_track(telemetry, pointer, size_old, 0, NULL); }
 	return NULL;
 }
 
 void system_memory_debug_init(void) {
-	gs_memory = NULL;
+	cbuffer_clear(CBM_(gs_system_memory_debug));
+	gs_system_memory_debug.sampling = (struct Memory_Debug_Sampling){
+		.period_count = 1,
+	};
+	gs_system_memory_debug.sites_index = (struct Hashmap){
+		.allocate = platform_reallocate,
+		.get_hash = system_memory_debug_hash_callstack,
+		.key_size = sizeof(struct Callstack),
+		.value_size = sizeof(uint32_t),
+	};
+	gs_system_memory_debug.sites = (struct Array){
+		.allocate = platform_reallocate,
+		.value_size = sizeof(struct Memory_Debug_Site),
+	};
+}
+
+struct Memory_Debug_Counters system_memory_debug_get_counters(void) {
+	struct Memory_Telemetry const telemetry = gs_system_memory_telemetry.types[MEMORY_TYPE_DEBUG];
+	return (struct Memory_Debug_Counters){
+		.allocate   = (uint32_t)telemetry.allocate,
+		.reallocate = (uint32_t)telemetry.reallocate,
+		.free       = (uint32_t)telemetry.free,
+	};
+}
+
+void system_memory_debug_set_sampling(struct Memory_Debug_Sampling value) {
+	gs_system_memory_debug.sampling = value;
+}
+
+void system_memory_debug_dump_profile(struct Buffer * buffer, enum Memory_Debug_Profile profile) {
+	platform_lock_acquire(&gs_system_memory_debug.sites_lock);
+
+	FOR_ARRAY(&gs_system_memory_debug.sites, it) {
+		struct Memory_Debug_Site const * site = it.value;
+		size_t const value
+			= (profile == MEMORY_DEBUG_PROFILE_LIVE) ? site->live_bytes
+			: (profile == MEMORY_DEBUG_PROFILE_PEAK) ? site->peak_bytes
+			: site->total_bytes;
+		if (value == 0) { continue; }
+
+		uint32_t frames_count = 0;
+		while (frames_count < SIZE_OF_ARRAY(site->callstack.data) && site->callstack.data[frames_count] != 0) {
+			frames_count++;
+		}
+
+		// @note: root first
+		for (uint32_t i = frames_count; i > 0; i--) {
+			uint64_t const address = site->callstack.data[i - 1];
+			struct CString const symbol = platform_debug_get_symbol(address);
+
+			buffer_ensure(buffer, buffer->size + symbol.length + 20); // `0x` and `UINT64_MAX` in hex, `;`
+			buffer->size += (symbol.length > 0)
+				? formatter_fmt(buffer->capacity - buffer->size, buffer_at_unsafe(buffer, buffer->size), "%.*s", symbol.length, symbol.data)
+				: formatter_fmt(buffer->capacity - buffer->size, buffer_at_unsafe(buffer, buffer->size), "%#llx", (unsigned long long)address);
+			if (i > 1) { buffer_push_many(buffer, 1, ";"); }
+		}
+
+		buffer_ensure(buffer, buffer->size + 22); // ` `, `SIZE_MAX`, `\n`
+		buffer->size += formatter_fmt(buffer->capacity - buffer->size, buffer_at_unsafe(buffer, buffer->size), " %zu\n", value);
+	}
+
+	platform_lock_release(&gs_system_memory_debug.sites_lock);
 }
 
 void system_memory_debug_free(void) {
 	system_memory_debug_report();
-	while (gs_memory != NULL) {
-		void * const header = gs_memory;
-		gs_memory = gs_memory->next;
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_DEBUG_SHARDS; i++) {
+		struct Memory_Debug_Shard * shard = gs_system_memory_debug.shards + i;
+		while (shard->list != NULL) {
+			void * const header = shard->list;
+			shard->list = shard->list->next;
+			platform_reallocate(header, 0);
+		}
+	}
+	hashmap_free(&gs_system_memory_debug.sites_index);
+	array_free(&gs_system_memory_debug.sites);
+}
+
+#undef SYSTEM_MEMORY_DEBUG_SHARDS
+
+// ----- ----- ----- ----- -----
+//     Pool part
+// ----- ----- ----- ----- -----
+
+// @note: blocks of power of two sizes, header included, are carved from slabs
+// and recycled via per class free lists; larger ones go to the platform;
+// each class is guarded by its own lock
+#define SYSTEM_MEMORY_POOL_SLAB_SIZE (16 * (1 << 10))
+#define SYSTEM_MEMORY_POOL_BLOCK_MIN_LOG2 5
+
+struct Memory_Pool_Slab {
+	struct Memory_Pool_Slab * next;
+	size_t padding; // keeps blocks aligned
+};
+
+struct Memory_Pool_Free {
+	struct Memory_Pool_Free * next;
+};
+
+static struct System_Memory_Pool {
+	struct Memory_Pool_Class {
+		struct Platform_Lock lock;
+		struct Memory_Pool_Slab * slabs;
+		struct Memory_Pool_Free * free_list;
+	} classes[SYSTEM_MEMORY_POOL_CLASSES];
+	struct Platform_Lock large_lock;
+	struct Memory_Pool_Stats stats;
+} gs_system_memory_pool;
+
+inline static size_t system_memory_pool_checksum(void const * pointer) {
+	return (size_t)pointer ^ 0xfedcba9876543210;
+}
+
+inline static uint32_t system_memory_pool_block_size(uint32_t class_index) {
+	return (uint32_t)1 << (class_index + SYSTEM_MEMORY_POOL_BLOCK_MIN_LOG2);
+}
+
+static uint32_t system_memory_pool_class_index(size_t size) {
+	size_t const block_size = sizeof(struct Memory_Header) + size;
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_POOL_CLASSES; i++) {
+		if (block_size <= system_memory_pool_block_size(i)) { return i; }
+	}
+	return SYSTEM_MEMORY_POOL_CLASSES;
+}
+
+static bool system_memory_pool_slab_push(uint32_t class_index) {
+	struct Memory_Pool_Class * pool_class = gs_system_memory_pool.classes + class_index;
+
+	struct Memory_Pool_Slab * slab = platform_reallocate(NULL, SYSTEM_MEMORY_POOL_SLAB_SIZE);
+	if (slab == NULL) { return false; }
+
+	*slab = (struct Memory_Pool_Slab){
+		.next = pool_class->slabs,
+	};
+	pool_class->slabs = slab;
+
+	uint32_t const block_size = system_memory_pool_block_size(class_index);
+	uint32_t const blocks_count = (SYSTEM_MEMORY_POOL_SLAB_SIZE - sizeof(*slab)) / block_size;
+
+	uint8_t * const blocks = (uint8_t *)(slab + 1);
+	for (uint32_t i = blocks_count; i > 0; i--) {
+		struct Memory_Pool_Free * block = (void *)(blocks + (size_t)block_size * (i - 1));
+		block->next = pool_class->free_list;
+		pool_class->free_list = block;
+	}
+
+	struct Memory_Pool_Class_Stats * stats = gs_system_memory_pool.stats.classes + class_index;
+	stats->slabs++;
+	stats->capacity += blocks_count;
+	return true;
+}
+
+static void * system_memory_pool_push(size_t size) {
+	uint32_t const class_index = system_memory_pool_class_index(size);
+	struct Memory_Header * header;
+
+	if (class_index < SYSTEM_MEMORY_POOL_CLASSES) {
+		struct Memory_Pool_Class * pool_class = gs_system_memory_pool.classes + class_index;
+		platform_lock_acquire(&pool_class->lock);
+
+		if (pool_class->free_list == NULL && !system_memory_pool_slab_push(class_index)) {
+			platform_lock_release(&pool_class->lock);
+			return NULL;
+		}
+
+		struct Memory_Pool_Free * block = pool_class->free_list;
+		pool_class->free_list = block->next;
+		header = (void *)block;
+
+		struct Memory_Pool_Class_Stats * stats = gs_system_memory_pool.stats.classes + class_index;
+		stats->count++;
+		stats->bytes += size;
+
+		platform_lock_release(&pool_class->lock);
+	}
+	else {
+		header = platform_reallocate(NULL, sizeof(*header) + size);
+		if (header == NULL) { return NULL; }
+
+		platform_lock_acquire(&gs_system_memory_pool.large_lock);
+		gs_system_memory_pool.stats.large_count++;
+		gs_system_memory_pool.stats.large_bytes += size;
+		platform_lock_release(&gs_system_memory_pool.large_lock);
+	}
+
+	*header = (struct Memory_Header){
+		.checksum = system_memory_pool_checksum(header),
+		.size = size,
+	};
+	return header + 1;
+}
+
+static void system_memory_pool_pop(struct Memory_Header * header) {
+	uint32_t const class_index = system_memory_pool_class_index(header->size);
+	size_t const size = header->size;
+	header->checksum = 0;
+
+	if (class_index < SYSTEM_MEMORY_POOL_CLASSES) {
+		struct Memory_Pool_Class * pool_class = gs_system_memory_pool.classes + class_index;
+		platform_lock_acquire(&pool_class->lock);
+
+		struct Memory_Pool_Free * block = (void *)header;
+		block->next = pool_class->free_list;
+		pool_class->free_list = block;
+
+		struct Memory_Pool_Class_Stats * stats = gs_system_memory_pool.stats.classes + class_index;
+		stats->count--;
+		stats->bytes -= size;
+
+		platform_lock_release(&pool_class->lock);
+	}
+	else {
 		platform_reallocate(header, 0);
+
+		platform_lock_acquire(&gs_system_memory_pool.large_lock);
+		gs_system_memory_pool.stats.large_count--;
+		gs_system_memory_pool.stats.large_bytes -= size;
+		platform_lock_release(&gs_system_memory_pool.large_lock);
+	}
+}
+
+ALLOCATOR(realloc_pool) {
+	system_memory_watch_check(pointer, size);
+
+	struct Memory_Header * header = (pointer != NULL)
+		? (struct Memory_Header *)pointer - 1
+		: NULL;
+
+	struct Memory_Pool_Stats * stats = &gs_system_memory_pool.stats;
+	struct Memory_Telemetry * telemetry = gs_system_memory_telemetry.types + MEMORY_TYPE_POOL;
+
+	if (header == NULL) {
+		if (size == 0) { return NULL; }
+		void * const result = system_memory_pool_push(size);
+		if (result != NULL) { system_memory_telemetry_track(telemetry, NULL, 0, size, result); }
+		return result;
+	}
+
+	if (header->checksum != system_memory_pool_checksum(header)) {
+		ERR("is not pool memory:");
+		REPORT_CALLSTACK(); DEBUG_BREAK();
+		return NULL;
+	}
+
+	size_t const size_old = header->size;
+	if (size == 0) {
+		system_memory_pool_pop(header);
+		system_memory_telemetry_track(telemetry, pointer, size_old, 0, NULL);
+		return NULL;
+	}
+
+	// @note: the block fits within its class
+	uint32_t const class_index = system_memory_pool_class_index(header->size);
+	if (class_index < SYSTEM_MEMORY_POOL_CLASSES && class_index == system_memory_pool_class_index(size)) {
+		struct Memory_Pool_Class * pool_class = gs_system_memory_pool.classes + class_index;
+		platform_lock_acquire(&pool_class->lock);
+		stats->classes[class_index].bytes -= header->size;
+		stats->classes[class_index].bytes += size;
+		platform_lock_release(&pool_class->lock);
+
+		header->size = size;
+		system_memory_telemetry_track(telemetry, pointer, size_old, size, pointer);
+		return pointer;
+	}
+
+	// @note: large blocks are left to the platform
+	if (class_index == SYSTEM_MEMORY_POOL_CLASSES && class_index == system_memory_pool_class_index(size)) {
+		size_t const checksum = header->checksum;
+		header->checksum = 0;
+
+		struct Memory_Header * result = platform_reallocate(header, sizeof(*header) + size);
+		if (result == NULL) {
+			// @note: the block is intact, keep it pool memory
+			header->checksum = checksum;
+			return NULL;
+		}
+		header = result;
+
+		platform_lock_acquire(&gs_system_memory_pool.large_lock);
+		stats->large_bytes -= size_old;
+		stats->large_bytes += size;
+		platform_lock_release(&gs_system_memory_pool.large_lock);
+
+		*header = (struct Memory_Header){
+			.checksum = system_memory_pool_checksum(header),
+			.size = size,
+		};
+		system_memory_telemetry_track(telemetry, pointer, size_old, size, header + 1);
+		return header + 1;
+	}
+
+	void * const pooled = system_memory_pool_push(size);
+	if (pooled == NULL) { return NULL; }
+
+	common_memcpy(pooled, pointer, min_size(size, size_old));
+	system_memory_pool_pop(header);
+	system_memory_telemetry_track(telemetry, pointer, size_old, size, pooled);
+	return pooled;
+}
+
+void system_memory_pool_init(void) {
+	cbuffer_clear(CBM_(gs_system_memory_pool));
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_POOL_CLASSES; i++) {
+		gs_system_memory_pool.stats.classes[i].block_size = system_memory_pool_block_size(i);
+	}
+}
+
+void system_memory_pool_free(void) {
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_POOL_CLASSES; i++) {
+		struct Memory_Pool_Class * pool_class = gs_system_memory_pool.classes + i;
+		while (pool_class->slabs != NULL) {
+			void * const slab = pool_class->slabs;
+			pool_class->slabs = pool_class->slabs->next;
+			platform_reallocate(slab, 0);
+		}
 	}
+	cbuffer_clear(CBM_(gs_system_memory_pool));
 }
 
+struct Memory_Pool_Stats system_memory_pool_get_stats(void) {
+	struct Memory_Telemetry const telemetry = gs_system_memory_telemetry.types[MEMORY_TYPE_POOL];
+	struct Memory_Pool_Stats result = gs_system_memory_pool.stats;
+	result.allocate   = (uint32_t)telemetry.allocate;
+	result.reallocate = (uint32_t)telemetry.reallocate;
+	result.free       = (uint32_t)telemetry.free;
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_POOL_CLASSES; i++) {
+		struct Memory_Pool_Class * pool_class = gs_system_memory_pool.classes + i;
+		platform_lock_acquire(&pool_class->lock);
+		result.classes[i] = gs_system_memory_pool.stats.classes[i];
+		platform_lock_release(&pool_class->lock);
+	}
+	return result;
+}
+
+#undef SYSTEM_MEMORY_POOL_SLAB_SIZE
+#undef SYSTEM_MEMORY_POOL_BLOCK_MIN_LOG2
+
 // ----- ----- ----- ----- -----
 //     Arena part
 // ----- ----- ----- ----- -----
 
+// @note: a bump allocator over a reserved virtual range, pages are committed on demand,
+// thus it grows in place; blocks are linked via `prev` offsets instead of a side array,
+// so out of order frees are reclaimed once they become the top;
+// each thread is handed its own arena from a registry on first use
+#define SYSTEM_MEMORY_ARENA_RESERVE (1 << 30)
+#define SYSTEM_MEMORY_ARENA_COMMIT_STEP (64 * (1 << 10))
+#define SYSTEM_MEMORY_ARENA_THREADS 16
+
+struct Memory_Header_Arena {
+	size_t prev;     // offset of the previous block, or `SIZE_MAX`
+	size_t sequence; // of the push, marks compare against it
+	struct Memory_Header base;
+};
+
+struct Memory_Arena {
+	void * volatile owner; // the arena itself, if handed out
+	enum Memory_Type type; // of the telemetry
+	uint8_t * data;
+	size_t reserved, committed;
+	size_t capacity; // committed as of the last clear
+	size_t size, top; // `top` is an offset of the last block, or `SIZE_MAX`
+	size_t sequence;  // of the last push
+	size_t peak;
+};
+
 static struct System_Memory_Arena {
-	struct Buffer  buffer;
-	struct Array   buffered; // `struct Memory_Header *`
-	struct Hashmap fallback; // `struct Memory_Header *` : NULL
-	size_t required, peak;
+	struct Memory_Arena arenas[SYSTEM_MEMORY_ARENA_THREADS];
 } gs_system_memory_arena;
 
+static THREAD_LOCAL struct Memory_Arena * gs_system_memory_arena_local;
+
 inline static size_t system_memory_arena_checksum(void const * pointer) {
 	return (size_t)pointer ^ 0x0123456789abcdef;
 }
 
+inline static size_t system_memory_arena_block_size(size_t size) {
+	// @note: keeps subsequent headers aligned
+	size_t const block_size = sizeof(struct Memory_Header_Arena) + size;
+	return (block_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+}
+
+static void system_memory_arena_reserve(struct Memory_Arena * arena, enum Memory_Type type) {
+	// @note: keeps the range of a previous owner
+	if (arena->data != NULL) { return; }
+
+	size_t const page_size = platform_memory_get_page_size();
+	size_t const reserved = (SYSTEM_MEMORY_ARENA_RESERVE + page_size - 1) / page_size * page_size;
+	arena->type = type;
+	arena->data = platform_memory_reserve(reserved);
+	arena->reserved = (arena->data != NULL) ? reserved : 0;
+	arena->top = SIZE_MAX;
+}
+
+static struct Memory_Arena * system_memory_arena_get_local(void) {
+	if (gs_system_memory_arena_local != NULL) { return gs_system_memory_arena_local; }
+
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_ARENA_THREADS; i++) {
+		struct Memory_Arena * arena = gs_system_memory_arena.arenas + i;
+		if (platform_atomic_compare_exchange(&arena->owner, NULL, arena) != NULL) { continue; }
+
+		system_memory_arena_reserve(arena, MEMORY_TYPE_ARENA);
+		gs_system_memory_arena_local = arena;
+		return arena;
+	}
+
+	ERR("arena registry is exhausted");
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	return NULL;
+}
+
+static bool system_memory_arena_commit(struct Memory_Arena * arena, size_t size) {
+	if (size <= arena->committed) { return true; }
+	if (size > arena->reserved) {
+		ERR("arena is out of reserved memory");
+		REPORT_CALLSTACK(); DEBUG_BREAK();
+		return false;
+	}
+
+	size_t const step = max_size(platform_memory_get_page_size(), SYSTEM_MEMORY_ARENA_COMMIT_STEP);
+	size_t const committed = min_size(
+		(size + step - 1) / step * step,
+		arena->reserved
+	);
+
+	if (!platform_memory_commit(arena->data + arena->committed, committed - arena->committed)) {
+		return false;
+	}
+
+	arena->committed = committed;
+	return true;
+}
+
+static void system_memory_arena_set_size(struct Memory_Arena * arena, size_t size) {
+	system_memory_telemetry_live(gs_system_memory_telemetry.types + arena->type, arena->size, size);
+	arena->size = size;
+	arena->peak = max_size(arena->peak, size);
+}
+
+static void system_memory_arena_reclaim(struct Memory_Arena * arena) {
+	// @note: drop freed blocks from the top
+	while (arena->top != SIZE_MAX) {
+		struct Memory_Header_Arena const * header = (void *)(arena->data + arena->top);
+		if (header->base.checksum != 0) { break; }
+
+		system_memory_arena_set_size(arena, arena->top);
+		arena->top = header->prev;
+	}
+}
+
 void system_memory_arena_init(void) {
-	gs_system_memory_arena = (struct System_Memory_Arena){
-		.buffer = {
-			.allocate = platform_reallocate,
-		},
-		.buffered = {
-			.allocate   = platform_reallocate,
-			.value_size = sizeof(struct Memory_Header *),
-		},
-		.fallback = {
-			.allocate = realloc_generic,
-			.get_hash = hash64,
-			.key_size = sizeof(struct Memory_Header *),
-		},
-	};
+	cbuffer_clear(CBM_(gs_system_memory_arena));
+	gs_system_memory_arena_local = NULL;
 }
 
 void system_memory_arena_free(void) {
-	FOR_HASHMAP(&gs_system_memory_arena.fallback, it) {
-		void * const * pointer = it.key;
-		gs_system_memory_arena.fallback.allocate(*pointer, 0);
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_ARENA_THREADS; i++) {
+		struct Memory_Arena * arena = gs_system_memory_arena.arenas + i;
+		system_memory_arena_set_size(arena, 0);
+		platform_memory_release(arena->data, arena->reserved);
 	}
-	buffer_free(&gs_system_memory_arena.buffer);
-	array_free(&gs_system_memory_arena.buffered);
-	hashmap_free(&gs_system_memory_arena.fallback);
+	cbuffer_clear(CBM_(gs_system_memory_arena));
+	gs_system_memory_arena_local = NULL;
 }
 
-void system_memory_arena_clear(void) {
+void system_memory_arena_detach(void) {
+	struct Memory_Arena * arena = gs_system_memory_arena_local;
+	if (arena == NULL) { return; }
+
+	system_memory_arena_set_size(arena, 0);
+	arena->top = SIZE_MAX;
+	gs_system_memory_arena_local = NULL;
+	platform_atomic_compare_exchange(&arena->owner, arena, NULL);
+}
+
+static void system_memory_arena_reset(struct Memory_Arena * arena) {
 	// growth
-	if (gs_system_memory_arena.buffer.capacity < gs_system_memory_arena.peak) {
+	if (arena->capacity < arena->peak) {
 		WRN(
 			"> arena system\n"
 			"  capacity .. %zu\n"
 			"  peak ...... %zu\n"
 			""
-			, gs_system_memory_arena.buffer.capacity
-			, gs_system_memory_arena.peak
+			, arena->capacity
+			, arena->peak
 		);
-		buffer_resize(&gs_system_memory_arena.buffer, gs_system_memory_arena.peak);
-	}
-	// dependencies
-	FOR_HASHMAP(&gs_system_memory_arena.fallback, it) {
-		void * const * pointer = it.key;
-		gs_system_memory_arena.fallback.allocate(*pointer, 0);
+		arena->capacity = arena->committed;
 	}
 	// personal
-	buffer_clear(&gs_system_memory_arena.buffer);
-	array_clear(&gs_system_memory_arena.buffered);
-	hashmap_clear(&gs_system_memory_arena.fallback);
-	gs_system_memory_arena.required = 0;
+	system_memory_arena_set_size(arena, 0);
+	arena->top = SIZE_MAX;
+}
+
+static void system_memory_arena_ensure_capacity(struct Memory_Arena * arena, size_t size) {
+	if (!system_memory_arena_commit(arena, size)) { return; }
+	arena->capacity = max_size(arena->capacity, arena->committed);
+}
+
+void system_memory_arena_clear(void) {
+	struct Memory_Arena * arena = system_memory_arena_get_local();
+	if (arena == NULL) { return; }
+	system_memory_arena_reset(arena);
 }
 
 void system_memory_arena_ensure(size_t size) {
-	buffer_ensure(&gs_system_memory_arena.buffer, size);
-	array_ensure(&gs_system_memory_arena.buffered, (uint32_t)(size / (1 << 10)));
+	struct Memory_Arena * arena = system_memory_arena_get_local();
+	if (arena == NULL) { return; }
+	system_memory_arena_ensure_capacity(arena, size);
+}
+
+struct Memory_Arena_Mark system_memory_arena_mark(void) {
+	struct Memory_Arena const * arena = system_memory_arena_get_local();
+	if (arena == NULL) { return (struct Memory_Arena_Mark){.top = SIZE_MAX}; }
+	return (struct Memory_Arena_Mark){
+		.size = arena->size,
+		.top  = arena->top,
+		.sequence = arena->sequence + 1,
+	};
 }
 
-static void * system_memory_arena_push(size_t size) {
+void system_memory_arena_rewind(struct Memory_Arena_Mark mark) {
+	struct Memory_Arena * arena = system_memory_arena_get_local();
+	if (arena == NULL) { return; }
+
+	// @note: blocks below the mark might have been freed and reclaimed since,
+	//        thus its offsets can't be trusted; newer blocks are always on top
+	while (arena->top != SIZE_MAX) {
+		struct Memory_Header_Arena const * header = (void *)(arena->data + arena->top);
+		if (header->sequence < mark.sequence) { break; }
+
+		system_memory_arena_set_size(arena, arena->top);
+		arena->top = header->prev;
+	}
+	system_memory_arena_reclaim(arena);
+}
+
+static void * system_memory_arena_push(struct Memory_Arena * arena, size_t size) {
 	if (size == 0) { return NULL; }
 
-	size_t const buffered_size = sizeof(struct Memory_Header) + size;
-	if (gs_system_memory_arena.buffer.size + buffered_size > gs_system_memory_arena.buffer.capacity) {
+	size_t const block_size = system_memory_arena_block_size(size);
+	size_t const offset = arena->size;
+	if (!system_memory_arena_commit(arena, offset + block_size)) { return NULL; }
+
+	system_memory_arena_set_size(arena, offset + block_size);
+
+	struct Memory_Header_Arena * header = (void *)(arena->data + offset);
+	*header = (struct Memory_Header_Arena){
+		.prev = arena->top,
+		.sequence = ++arena->sequence,
+		.base = {
+			.checksum = system_memory_arena_checksum(header),
+			.size = size,
+		},
+	};
+	arena->top = offset;
+
+	return header + 1;
+}
+
+static void system_memory_arena_pop(struct Memory_Arena * arena, struct Memory_Header_Arena * header) {
+	header->base.checksum = 0;
+	system_memory_arena_reclaim(arena);
+}
+
+static bool system_memory_arena_resize_top(struct Memory_Arena * arena, struct Memory_Header_Arena * header, size_t size) {
+	if (arena->top == SIZE_MAX) { return false; }
+
+	uint8_t * top = arena->data + arena->top;
+	if ((uint8_t *)header != top) { return false; }
+
+	size_t const size_end = arena->top + system_memory_arena_block_size(size);
+	if (!system_memory_arena_commit(arena, size_end)) { return false; }
+
+	system_memory_arena_set_size(arena, size_end);
+
+	header->base.size = size;
+	return true;
+}
+
+static bool system_memory_arena_contains(struct Memory_Arena const * arena, struct Memory_Header_Arena const * header) {
+	bool const is_local = ((uint8_t const *)header >= arena->data) && ((uint8_t const *)header < arena->data + arena->size);
+	return is_local && header->base.checksum == system_memory_arena_checksum(header);
+}
+
+// @note: expects `pointer` to be of the `arena`, if any
+static void * system_memory_arena_reallocate(struct Memory_Arena * arena, void * pointer, size_t size) {
+	struct Memory_Header_Arena * header = (pointer != NULL)
+		? (struct Memory_Header_Arena *)pointer - 1
+		: NULL;
+
+	// @note: bytes are tracked by the arena itself
+	struct Memory_Telemetry * telemetry = gs_system_memory_telemetry.types + arena->type;
+
+	if (header == NULL) {
+		void * const result = system_memory_arena_push(arena, size);
+		if (result != NULL) { system_memory_telemetry_calls(telemetry, NULL, 0, size, result); }
+		return result;
+	}
+
+	size_t const size_old = header->base.size;
+	if (size == 0) {
+		system_memory_arena_pop(arena, header);
+		system_memory_telemetry_calls(telemetry, pointer, size_old, 0, NULL);
 		return NULL;
 	}
 
-	gs_system_memory_arena.required += buffered_size;
-	gs_system_memory_arena.peak = max_size(gs_system_memory_arena.peak, gs_system_memory_arena.required);
+	// @note: the top block grows or shrinks in place
+	if (system_memory_arena_resize_top(arena, header, size)) {
+		system_memory_telemetry_calls(telemetry, pointer, size_old, size, pointer);
+		return pointer;
+	}
 
-	size_t const offset = gs_system_memory_arena.buffer.size;
-	gs_system_memory_arena.buffer.size += buffered_size;
+	void * const buffered = system_memory_arena_push(arena, size);
+	if (buffered == NULL) { return NULL; }
 
-	struct Memory_Header * header = buffer_at(&gs_system_memory_arena.buffer, offset);
-	array_push_many(&gs_system_memory_arena.buffered, 1, &header);
+	common_memcpy(buffered, pointer, min_size(size, size_old));
+	system_memory_arena_pop(arena, header);
+	system_memory_telemetry_calls(telemetry, pointer, size_old, size, buffered);
+	return buffered;
+}
 
-	*header = (struct Memory_Header){
-		.checksum = system_memory_arena_checksum(header),
-		.size = size,
+ALLOCATOR(realloc_arena) {
+	struct Memory_Arena * arena = system_memory_arena_get_local();
+	if (arena == NULL) { return NULL; }
+
+	if (pointer != NULL && !system_memory_arena_contains(arena, (struct Memory_Header_Arena *)pointer - 1)) {
+		ERR("is not arena memory of this thread:");
+		REPORT_CALLSTACK(); DEBUG_BREAK();
+		return NULL;
+	}
+
+	return system_memory_arena_reallocate(arena, pointer, size);
+}
+
+// ----- ----- ----- ----- -----
+//     Frame part
+// ----- ----- ----- ----- -----
+
+// @note: arenas of the arena part, guarded by a lock instead of being local
+static struct System_Memory_Frame {
+	struct Platform_Lock lock;
+	struct Memory_Arena arenas[2];
+	uint32_t current;
+} gs_system_memory_frame;
+
+// @note: expects `pointer` to be of the `previous` arena
+static void * system_memory_frame_carry(struct Memory_Arena * current, struct Memory_Arena * previous, void * pointer, size_t size) {
+	struct Memory_Header_Arena * header = (struct Memory_Header_Arena *)pointer - 1;
+	size_t const size_old = header->base.size;
+
+	void * const result = system_memory_arena_push(current, size);
+	if (result == NULL && size != 0) { return NULL; }
+
+	if (result != NULL) { common_memcpy(result, pointer, min_size(size, size_old)); }
+	system_memory_arena_pop(previous, header);
+
+	struct Memory_Telemetry * telemetry = gs_system_memory_telemetry.types + MEMORY_TYPE_FRAME;
+	system_memory_telemetry_calls(telemetry, pointer, size_old, size, result);
+	return result;
+}
+
+ALLOCATOR(realloc_frame) {
+	struct Memory_Header_Arena const * header = (pointer != NULL)
+		? (struct Memory_Header_Arena *)pointer - 1
+		: NULL;
+
+	platform_lock_acquire(&gs_system_memory_frame.lock);
+	struct Memory_Arena * current  = gs_system_memory_frame.arenas + gs_system_memory_frame.current;
+	struct Memory_Arena * previous = gs_system_memory_frame.arenas + (gs_system_memory_frame.current ^ 1);
+	system_memory_arena_reserve(current, MEMORY_TYPE_FRAME);
+
+	void * result = NULL;
+	bool is_valid = true;
+	if (header == NULL || system_memory_arena_contains(current, header)) {
+		result = system_memory_arena_reallocate(current, pointer, size);
+	}
+	else if (system_memory_arena_contains(previous, header)) {
+		result = system_memory_frame_carry(current, previous, pointer, size);
+	}
+	else { is_valid = false; }
+	platform_lock_release(&gs_system_memory_frame.lock);
+
+	if (!is_valid) {
+		ERR("is not frame memory:");
+		REPORT_CALLSTACK(); DEBUG_BREAK();
+	}
+	return result;
+}
+
+void system_memory_frame_init(void) {
+	cbuffer_clear(CBM_(gs_system_memory_frame));
+}
+
+void system_memory_frame_free(void) {
+	for (uint32_t i = 0; i < 2; i++) {
+		struct Memory_Arena * arena = gs_system_memory_frame.arenas + i;
+		system_memory_arena_set_size(arena, 0);
+		platform_memory_release(arena->data, arena->reserved);
+	}
+	cbuffer_clear(CBM_(gs_system_memory_frame));
+}
+
+void system_memory_frame_swap(void) {
+	platform_lock_acquire(&gs_system_memory_frame.lock);
+	gs_system_memory_frame.current ^= 1;
+	struct Memory_Arena * current = gs_system_memory_frame.arenas + gs_system_memory_frame.current;
+	system_memory_arena_reserve(current, MEMORY_TYPE_FRAME);
+	system_memory_arena_reset(current);
+	platform_lock_release(&gs_system_memory_frame.lock);
+}
+
+void system_memory_frame_ensure(size_t size) {
+	platform_lock_acquire(&gs_system_memory_frame.lock);
+	for (uint32_t i = 0; i < 2; i++) {
+		struct Memory_Arena * arena = gs_system_memory_frame.arenas + i;
+		system_memory_arena_reserve(arena, MEMORY_TYPE_FRAME);
+		system_memory_arena_ensure_capacity(arena, size);
+	}
+	platform_lock_release(&gs_system_memory_frame.lock);
+}
+
+#undef SYSTEM_MEMORY_ARENA_RESERVE
+#undef SYSTEM_MEMORY_ARENA_COMMIT_STEP
+#undef SYSTEM_MEMORY_ARENA_THREADS
+
+// ----- ----- ----- ----- -----
+//     Heap part
+// ----- ----- ----- ----- -----
+
+// @note: heaps live in a registry, thus cost no allocations on their own;
+// blocks are linked into a list, which is guarded by the heap lock
+#define SYSTEM_MEMORY_HEAPS 16
+
+struct Memory_Header_Heap {
+	struct Memory_Header_Heap * prev, * next;
+	struct Memory_Header base;
+};
+
+struct Memory_Heap {
+	struct Allocator_Context base;
+	struct CString name;
+	Allocator * allocate;
+	uint32_t ref_count; // `0` is a free slot
+	struct Platform_Lock lock;
+	struct Memory_Header_Heap * list;
+	struct Memory_Telemetry telemetry;
+};
+
+static struct System_Memory_Heaps {
+	struct Platform_Lock lock;
+	struct Memory_Heap heaps[SYSTEM_MEMORY_HEAPS];
+} gs_system_memory_heaps;
+
+inline static size_t system_memory_heap_checksum(void const * pointer, struct Memory_Heap const * heap) {
+	return (size_t)pointer ^ (size_t)heap;
+}
+
+static void system_memory_heap_link(struct Memory_Heap * heap, struct Memory_Header_Heap * header, size_t size) {
+	*header = (struct Memory_Header_Heap){
+		.base = {
+			.checksum = system_memory_heap_checksum(header, heap),
+			.size = size,
+		},
 	};
 
-	return header + 1;
+	platform_lock_acquire(&heap->lock);
+	header->next = heap->list;
+	if (heap->list != NULL) { heap->list->prev = header; }
+	heap->list = header;
+	platform_lock_release(&heap->lock);
 }
 
-static struct Memory_Header * system_memory_arena_pop(void * pointer) {
-	if (pointer == NULL) { return NULL; }
+static CONTEXT_ALLOCATOR(system_memory_heap_reallocate) {
+	struct Memory_Heap * heap = (struct Memory_Heap *)(void *)context;
 
-	struct Memory_Header * header = (struct Memory_Header *)pointer - 1;
-	if (header->checksum != system_memory_arena_checksum(header)) { return NULL; }
-	header->checksum = 0;
+	struct Memory_Header_Heap * header = (pointer != NULL)
+		? (struct Memory_Header_Heap *)pointer - 1
+		: NULL;
 
-	for (uint32_t i = gs_system_memory_arena.buffered.count; i > 0; i--) {
-		void * const * it = array_at(&gs_system_memory_arena.buffered, i - 1);
-		struct Memory_Header const * buffered = *it;
-		if (buffered->checksum != 0) { break; }
+	if (header != NULL) {
+		if (header->base.checksum != system_memory_heap_checksum(header, heap)) {
+			ERR("is not memory of the heap \"%.*s\":", heap->name.length, heap->name.data);
+			REPORT_CALLSTACK(); DEBUG_BREAK();
+			return NULL;
+		}
+		header->base.checksum = 0;
 
-		size_t const buffered_size = sizeof(*buffered) + buffered->size;
-		gs_system_memory_arena.required -= buffered_size;
+		platform_lock_acquire(&heap->lock);
+		if (heap->list == header) { heap->list = header->next; }
+		if (header->next != NULL) { header->next->prev = header->prev; }
+		if (header->prev != NULL) { header->prev->next = header->next; }
+		platform_lock_release(&heap->lock);
+	}
 
-		gs_system_memory_arena.buffer.size -= buffered_size;
-		gs_system_memory_arena.buffered.count -= 1;
+	size_t const size_old = (header != NULL) ? header->base.size : 0;
+
+	struct Memory_Header_Heap * result = heap->allocate(header, (size != 0)
+		? sizeof(*header) + size
+		: 0
+	);
+
+	if (result != NULL) {
+		system_memory_heap_link(heap, result, size);
+		system_memory_telemetry_track(&heap->telemetry, pointer, size_old, size, result + 1);
+		return result + 1;
 	}
 
-	return header;
+	if (size == 0) {
+		system_memory_telemetry_track(&heap->telemetry, pointer, size_old, 0, NULL);
+		return NULL;
+	}
+
+	// @note: a failed reallocation leaves the block intact, thus it stays in the heap
+	if (header != NULL) { system_memory_heap_link(heap, header, size_old); }
+	return NULL;
 }
 
-static ALLOCATOR(arena_fallback) {
-	if (pointer != NULL) {
-		if (!hashmap_del(&gs_system_memory_arena.fallback, &pointer)) {
-			DEBUG_BREAK();
+struct Memory_Heap * system_memory_heap_init(struct CString name, Allocator * allocate) {
+	platform_lock_acquire(&gs_system_memory_heaps.lock);
+
+	struct Memory_Heap * heap = NULL, * vacant = NULL;
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_HEAPS; i++) {
+		struct Memory_Heap * it = gs_system_memory_heaps.heaps + i;
+		if (it->ref_count == 0) {
+			if (vacant == NULL) { vacant = it; }
+			continue;
 		}
-		struct Memory_Header const * header = (struct Memory_Header *)pointer - 1;
-		gs_system_memory_arena.required -= sizeof(*header) + header->size;
+		if (cstring_equals(it->name, name)) { heap = it; break; }
+	}
+
+	if (heap == NULL && vacant != NULL) {
+		heap = vacant;
+		*heap = (struct Memory_Heap){
+			.base = {
+				.invoke = system_memory_heap_reallocate,
+			},
+			.name = name,
+			.allocate = (allocate != NULL) ? allocate : DEFAULT_REALLOCATOR,
+		};
+	}
+
+	if (heap != NULL) { heap->ref_count++; }
+
+	platform_lock_release(&gs_system_memory_heaps.lock);
+
+	if (heap == NULL) {
+		ERR("memory heaps are exhausted: \"%.*s\"", name.length, name.data);
+		REPORT_CALLSTACK(); DEBUG_BREAK();
 	}
+	return heap;
+}
 
-	void * pointer1 = gs_system_memory_arena.fallback.allocate(pointer, size);
-	if (pointer1 == NULL) { return NULL; }
+void system_memory_heap_free(struct Memory_Heap * heap) {
+	if (heap == NULL) { return; }
 
-	if (!hashmap_set(&gs_system_memory_arena.fallback, &pointer1, NULL)) {
-		DEBUG_BREAK();
+	// @note: the registry stays locked, so that the slot is not claimed midway
+	platform_lock_acquire(&gs_system_memory_heaps.lock);
+	if (--heap->ref_count == 0) {
+		while (heap->list != NULL) {
+			struct Memory_Header_Heap * header = heap->list;
+			heap->list = header->next;
+
+			system_memory_telemetry_track(&heap->telemetry, header + 1, header->base.size, 0, NULL);
+			header->base.checksum = 0;
+			heap->allocate(header, 0);
+		}
+		cbuffer_clear(CBMP_(heap));
 	}
-	pointer = pointer1;
+	platform_lock_release(&gs_system_memory_heaps.lock);
+}
 
-	gs_system_memory_arena.required += sizeof(struct Memory_Header) + size;
-	gs_system_memory_arena.peak = max_size(gs_system_memory_arena.peak, gs_system_memory_arena.required);
+struct Allocator_Context * system_memory_heap_get_context(struct Memory_Heap * heap) {
+	return (heap != NULL) ? &heap->base : NULL;
+}
 
-	return pointer;
+struct Memory_Telemetry system_memory_heap_get_telemetry(struct Memory_Heap const * heap) {
+	return (heap != NULL) ? heap->telemetry : (struct Memory_Telemetry){0};
 }
 
-ALLOCATOR(realloc_arena) {
-	struct Memory_Header const * header = system_memory_arena_pop(pointer);
-	void * const buffered = system_memory_arena_push(size);
+static void system_memory_heap_dump(struct Buffer * buffer, uint64_t frame) {
+	platform_lock_acquire(&gs_system_memory_heaps.lock);
+	for (uint32_t i = 0; i < SYSTEM_MEMORY_HEAPS; i++) {
+		struct Memory_Heap const * heap = gs_system_memory_heaps.heaps + i;
+		if (heap->ref_count == 0) { continue; }
+		system_memory_telemetry_dump_row(buffer, frame, S_("heap:"), heap->name, heap->telemetry);
+	}
+	platform_lock_release(&gs_system_memory_heaps.lock);
+}
+
+#undef SYSTEM_MEMORY_HEAPS
 
+// ----- ----- ----- ----- -----
+//     Aligned part
+// ----- ----- ----- ----- -----
+
+struct Memory_Header_Aligned {
+	size_t offset; // of the data within the underlying block
+	struct Memory_Header base;
+};
+
+inline static size_t system_memory_aligned_checksum(void const * pointer) {
+	return (size_t)pointer ^ 0x5a5a5a5a5a5a5a5a;
+}
+
+void * realloc_aligned(Allocator * allocate, struct Allocator_Context * context, void * pointer, size_t size, size_t alignment) {
+	if (alignment <= sizeof(size_t)) {
+		return realloc_context(allocate, context, pointer, size);
+	}
+
+	if ((alignment & (alignment - 1)) != 0) {
+		ERR("alignment is not a power of two: %zu", alignment);
+		REPORT_CALLSTACK(); DEBUG_BREAK();
+		return NULL;
+	}
+
+	struct Memory_Header_Aligned * header = (pointer != NULL)
+		? (struct Memory_Header_Aligned *)pointer - 1
+		: NULL;
+
+	uint8_t * block = NULL;
+	size_t offset_old = 0, size_old = 0;
 	if (header != NULL) {
-		// buffered -> buffered
-		if (buffered != NULL) { return buffered; }
-		if (size == 0) { return buffered; }
+		if (header->base.checksum != system_memory_aligned_checksum(header)) {
+			ERR("is not aligned memory:");
+			REPORT_CALLSTACK(); DEBUG_BREAK();
+			return NULL;
+		}
+		offset_old = header->offset;
+		size_old = header->base.size;
+		block = (uint8_t *)pointer - offset_old;
+	}
 
-		// buffered -> fallback
-		void * const fallback = arena_fallback(NULL, size);
-		common_memcpy(fallback, pointer, min_size(size, header->size));
-		return fallback;
+	if (size == 0) {
+		if (header != NULL) { header->base.checksum = 0; }
+		realloc_context(allocate, context, block, 0);
+		return NULL;
 	}
 
-	// fallback -> fallback
-	if (buffered == NULL && size != 0) {
-		return arena_fallback(pointer, size);
+	block = realloc_context(allocate, context, block, sizeof(*header) + (alignment - 1) + size);
+	if (block == NULL) { return NULL; }
+
+	size_t const address = (size_t)(block + sizeof(*header));
+	size_t const offset = sizeof(*header) + (((address + alignment - 1) & ~(alignment - 1)) - address);
+
+	// @note: the underlying block might have moved to a different alignment
+	if (header != NULL && offset != offset_old) {
+		common_memmove(block + offset, block + offset_old, min_size(size_old, size));
 	}
 
-	// fallback -> buffered
-	common_memcpy(buffered, pointer, size);
-	arena_fallback(pointer, 0);
-	return buffered;
+	header = (struct Memory_Header_Aligned *)(void *)(block + offset) - 1;
+	*header = (struct Memory_Header_Aligned){
+		.offset = offset,
+		.base = {
+			.checksum = system_memory_aligned_checksum(header),
+			.size = size,
+		},
+	};
+	return header + 1;
 }
@@ -3,10 +3,61 @@
 
 #include "framework/common.h"
 
+struct Buffer;
+
 struct Memory_Header {
 	size_t checksum, size;
 };
 
+// ----- ----- ----- ----- -----
+//     Telemetry part
+// ----- ----- ----- ----- -----
+
+enum Memory_Type {
+	MEMORY_TYPE_PLATFORM,
+	MEMORY_TYPE_GENERIC,
+	MEMORY_TYPE_DEBUG,
+	MEMORY_TYPE_POOL,
+	MEMORY_TYPE_ARENA,
+	MEMORY_TYPE_FRAME,
+	//
+	MEMORY_TYPE_COUNT,
+};
+
+// @note: counted since the start of the process; arenas count bytes they hold,
+// which includes headers and freed blocks below the top, others count requested bytes
+struct Memory_Telemetry {
+	uint64_t allocate, reallocate, free; // calls
+	uint64_t copied;                     // bytes moved by reallocations
+	uint64_t live, peak;                 // bytes in use
+};
+
+struct Memory_Telemetry system_memory_get_telemetry(enum Memory_Type type);
+
+// @note: tags attribute calls to a name, say, of a container instance, on top of
+// the allocator; `name` should outlive the process; returns `tag + 1`
+uint32_t system_memory_tag_register(struct CString name);
+struct Memory_Telemetry system_memory_get_tag_telemetry(uint32_t tag_id);
+void * system_memory_tag_reallocate(uint32_t tag_id, Allocator * allocate, void * pointer, size_t size);
+
+// @note: defines a tagged allocator over one of this file
+#define MEMORY_TAGGED_ALLOCATOR(func, name, allocator) \
+	ALLOCATOR(func) { \
+		static uint32_t tag_id = 0; \
+		if (tag_id == 0) { tag_id = system_memory_tag_register(S_(name)); } \
+		return system_memory_tag_reallocate(tag_id, allocator, pointer, size); \
+	}
+
+// @note: counts heap allocations and reallocations of the calling thread until
+// the watch ends, reporting each with its callsite; arenas and frees are exempt
+void system_memory_watch_begin(void);
+uint32_t system_memory_watch_end(void);
+
+// @note: appends a `frame,source,allocate,reallocate,free,copied,live,peak` row
+// per allocator, per tag and per heap; the header row is separate
+void system_memory_telemetry_dump_header(struct Buffer * buffer);
+void system_memory_telemetry_dump(struct Buffer * buffer, uint64_t frame);
+
 // ----- ----- ----- ----- -----
 //     Generic part
 // ----- ----- ----- ----- -----
@@ -30,6 +81,62 @@ ALLOCATOR(realloc_debug);
 void system_memory_debug_init(void);
 void system_memory_debug_free(void);
 
+struct Memory_Debug_Counters {
+	uint32_t allocate, reallocate, free; // calls, same as the telemetry
+};
+
+struct Memory_Debug_Counters system_memory_debug_get_counters(void);
+
+// @note: only sampled allocations capture a callstack, which attributes them to a call site;
+// a sample stands for `period_count` allocations or `period_bytes` bytes, whichever hits;
+// `0` disables a criterion; the default is to sample every allocation
+struct Memory_Debug_Sampling {
+	uint32_t period_count;
+	size_t period_bytes;
+};
+
+void system_memory_debug_set_sampling(struct Memory_Debug_Sampling value);
+
+enum Memory_Debug_Profile {
+	MEMORY_DEBUG_PROFILE_LIVE,  // estimated bytes in use
+	MEMORY_DEBUG_PROFILE_PEAK,  // estimated bytes in use at most, per site
+	MEMORY_DEBUG_PROFILE_TOTAL, // estimated bytes ever allocated
+};
+
+// @note: appends collapsed stacks, a `root;...;leaf bytes` line per call site,
+// compatible with `flamegraph.pl` and `pprof -raw` converters
+void system_memory_debug_dump_profile(struct Buffer * buffer, enum Memory_Debug_Profile profile);
+
+// ----- ----- ----- ----- -----
+//     Pool part
+// ----- ----- ----- ----- -----
+
+ALLOCATOR(realloc_pool);
+
+#define POOL_FREE(pointer) realloc_pool(pointer, 0)
+#define POOL_ALLOCATE(type) realloc_pool((type *)NULL, sizeof(type))
+#define POOL_ALLOCATE_ARRAY(type, count) realloc_pool((type *)NULL, sizeof(type) * (size_t)(count))
+
+void system_memory_pool_init(void);
+void system_memory_pool_free(void);
+
+// @note: size classes are 32 to 2048 bytes blocks, header included
+#define SYSTEM_MEMORY_POOL_CLASSES 7
+
+struct Memory_Pool_Stats {
+	struct Memory_Pool_Class_Stats {
+		uint32_t block_size;
+		uint32_t slabs, capacity; // blocks in slabs
+		uint32_t count;           // blocks in use
+		size_t bytes;             // requested by blocks in use
+	} classes[SYSTEM_MEMORY_POOL_CLASSES];
+	uint32_t large_count; // beyond the classes
+	size_t large_bytes;
+	uint32_t allocate, reallocate, free; // calls, same as the telemetry
+};
+
+struct Memory_Pool_Stats system_memory_pool_get_stats(void);
+
 // ----- ----- ----- ----- -----
 //     Arena part
 // ----- ----- ----- ----- -----
@@ -40,18 +147,91 @@ ALLOCATOR(realloc_arena);
 #define ARENA_ALLOCATE(type) realloc_arena((type *)NULL, sizeof(type))
 #define ARENA_ALLOCATE_ARRAY(type, count) realloc_arena((type *)NULL, sizeof(type) * (size_t)(count))
 
+// @note: each thread uses an arena of its own
 void system_memory_arena_init(void);
 void system_memory_arena_free(void);
 
+// @note: hands the arena of the calling thread back, say, before the thread exits
+void system_memory_arena_detach(void);
+
 void system_memory_arena_clear(void);
 void system_memory_arena_ensure(size_t size);
 
+// @note: a position to rewind to, releasing everything allocated since at once,
+// even if blocks below it were freed meanwhile; invalidated by `system_memory_arena_clear`
+struct Memory_Arena_Mark {
+	size_t size, top;
+	size_t sequence; // of the first block allocated since
+};
+
+struct Memory_Arena_Mark system_memory_arena_mark(void);
+void system_memory_arena_rewind(struct Memory_Arena_Mark mark);
+
+// ----- ----- ----- ----- -----
+//     Frame part
+// ----- ----- ----- ----- -----
+
+// @note: a pair of arenas, current and previous, shared by the threads;
+// a block lives until the end of the next frame, thus data of a frame can be
+// consumed by the next one; reallocating a block of the previous frame carries
+// it over into the current one; containers of it are dropped each frame
+// instead of being freed, the arena reclaims their storage
+ALLOCATOR(realloc_frame);
+
+#define FRAME_FREE(pointer) realloc_frame(pointer, 0)
+#define FRAME_ALLOCATE(type) realloc_frame((type *)NULL, sizeof(type))
+#define FRAME_ALLOCATE_ARRAY(type, count) realloc_frame((type *)NULL, sizeof(type) * (size_t)(count))
+
+void system_memory_frame_init(void);
+void system_memory_frame_free(void);
+
+// @note: releases blocks of the previous frame, then it becomes the current one;
+// expected once per frame, when no other thread allocates
+void system_memory_frame_swap(void);
+void system_memory_frame_ensure(size_t size);
+
+// ----- ----- ----- ----- -----
+//     Heap part
+// ----- ----- ----- ----- -----
+
+// @note: a named context over any allocator of this file, which links its blocks,
+// thus a subsystem accounts for its memory on its own and can free it at once;
+// `init` with a taken name shares the heap, the last `free` releases the blocks;
+// `name` should outlive the heap
+struct Memory_Heap;
+
+struct Memory_Heap * system_memory_heap_init(struct CString name, Allocator * allocate);
+void system_memory_heap_free(struct Memory_Heap * heap);
+
+struct Allocator_Context * system_memory_heap_get_context(struct Memory_Heap * heap);
+struct Memory_Telemetry system_memory_heap_get_telemetry(struct Memory_Heap const * heap);
+
+// @note: prefers the `context`, if any
+inline static void * realloc_context(Allocator * allocate, struct Allocator_Context * context, void * pointer, size_t size) {
+	return (context != NULL)
+		? context->invoke(context, pointer, size)
+		: allocate(pointer, size);
+}
+
+// ----- ----- ----- ----- -----
+//     Aligned part
+// ----- ----- ----- ----- -----
+
+// @note: over-allocates via any allocator of this file and aligns the data within,
+// thus shares its growth in place; `alignment` is a power of two and should stay
+// the same for a block; the allocators align at `sizeof(size_t)` on their own
+void * realloc_aligned(Allocator * allocate, struct Allocator_Context * context, void * pointer, size_t size, size_t alignment);
+
+#define ALIGNED_FREE(allocate, pointer, alignment) realloc_aligned(allocate, NULL, pointer, 0, alignment)
+#define ALIGNED_ALLOCATE(allocate, type, alignment) realloc_aligned(allocate, NULL, (type *)NULL, sizeof(type), alignment)
+#define ALIGNED_ALLOCATE_ARRAY(allocate, type, count, alignment) realloc_aligned(allocate, NULL, (type *)NULL, sizeof(type) * (size_t)(count), alignment)
+
 // ----- ----- ----- ----- -----
 //     Default part
 // ----- ----- ----- ----- -----
 
 #if defined(GAME_TARGET_RELEASE)
-	#define DEFAULT_REALLOCATOR realloc_generic
+	#define DEFAULT_REALLOCATOR realloc_pool
 #else
 	#define DEFAULT_REALLOCATOR realloc_debug
 #endif
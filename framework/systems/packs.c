@@ -0,0 +1,243 @@
+#include "framework/maths.h"
+#include "framework/formatter.h"
+#include "framework/platform/file.h"
+#include "framework/containers/array.h"
+
+
+//
+#include "packs.h"
+
+#define PACK_MAGIC   0x4B434150 // "PACK"
+#define PACK_VERSION 1
+
+// @note: entries follow the header, names follow the entries
+struct Pack_Header {
+	uint32_t magic, version;
+	uint32_t count, alignment;
+};
+
+struct Pack_Entry {
+	uint32_t name_hash, name_length;
+	uint64_t name_offset;
+	uint64_t offset, size;
+	uint64_t content_hash;
+};
+
+static struct Packs {
+	struct Array views; // `struct CBuffer`
+} gs_packs;
+
+void system_packs_init(void) {
+	gs_packs = (struct Packs){
+		.views = array_init(sizeof(struct CBuffer)),
+	};
+}
+
+void system_packs_free(void) {
+	FOR_ARRAY(&gs_packs.views, it) {
+		struct CBuffer const * view = it.value;
+		platform_file_unmap(*view);
+	}
+	array_free(&gs_packs.views);
+	cbuffer_clear(CBM_(gs_packs));
+}
+
+bool system_packs_mount(struct CString path) {
+	struct CBuffer const view = platform_file_map(path);
+	if (view.data == NULL) { return false; }
+
+	struct Pack_Header const * header = view.data;
+	if (view.size < sizeof(*header))       { goto fail; }
+	if (header->magic != PACK_MAGIC)       { goto fail; }
+	if (header->version != PACK_VERSION)   { goto fail; }
+	if (header->alignment != PACK_ALIGNMENT) { goto fail; }
+	if (view.size < sizeof(*header) + header->count * sizeof(struct Pack_Entry)) { goto fail; }
+
+	// @note: lookups trust the index, thus a truncated or stale pack is rejected whole
+	uint8_t const * base = view.data;
+	struct Pack_Entry const * entries = (void const *)(header + 1);
+	for (uint32_t i = 0; i < header->count; i++) {
+		struct Pack_Entry const * entry = entries + i;
+		if (entry->name_offset > view.size)                      { goto fail; }
+		if (entry->name_length > view.size - entry->name_offset) { goto fail; }
+		if (entry->offset > view.size)                           { goto fail; }
+		if (entry->size >= view.size - entry->offset)            { goto fail; }
+		if (base[entry->offset + entry->size] != '\0')           { goto fail; }
+	}
+
+	array_push_many(&gs_packs.views, 1, &view);
+	return true;
+
+	// process errors
+	fail: WRN("not a pack: \"%.*s\"", path.length, path.data);
+	platform_file_unmap(view);
+	return false;
+}
+
+struct CBuffer system_packs_find(struct CString name) {
+	uint32_t const name_hash = hash_u32_fnv1((uint8_t const *)name.data, name.length);
+	for (uint32_t i = gs_packs.views.count; i > 0; i--) {
+		struct CBuffer const * view = array_at(&gs_packs.views, i - 1);
+		uint8_t const * base = view->data;
+
+		struct Pack_Header const * header = view->data;
+		struct Pack_Entry const * entries = (void const *)(header + 1);
+
+		// @note: the first entry of the hash
+		uint32_t low = 0, high = header->count;
+		while (low < high) {
+			uint32_t const middle = low + (high - low) / 2;
+			if (entries[middle].name_hash < name_hash) { low = middle + 1; }
+			else                                       { high = middle; }
+		}
+
+		for (uint32_t entry_i = low; entry_i < header->count; entry_i++) {
+			struct Pack_Entry const * entry = entries + entry_i;
+			if (entry->name_hash != name_hash) { break; }
+
+			struct CString const entry_name = {
+				.length = entry->name_length,
+				.data = (char const *)(base + entry->name_offset),
+			};
+			if (!cstring_equals(entry_name, name)) { continue; }
+
+		#if !defined(GAME_TARGET_RELEASE)
+			if (hash_u64_fnv1(base + entry->offset, entry->size) != entry->content_hash) {
+				WRN("pack entry is corrupted: \"%.*s\"", name.length, name.data);
+			}
+		#endif
+
+			return (struct CBuffer){
+				.size = entry->size,
+				.data = base + entry->offset,
+			};
+		}
+	}
+	return (struct CBuffer){0};
+}
+
+struct Buffer system_packs_read(struct CString name) {
+	struct CBuffer const view = system_packs_find(name);
+	if (view.data == NULL) { return platform_file_read_entire(name); }
+	return (struct Buffer){
+		.capacity = view.size,
+		.size = view.size,
+		.data = (void *)(size_t)view.data,
+	};
+}
+
+struct Pack_Source {
+	uint32_t name_hash;
+	struct CString name;
+};
+
+static COMPARATOR(pack_source_compare) {
+	struct Pack_Source const * source1 = v1;
+	struct Pack_Source const * source2 = v2;
+	if (source1->name_hash < source2->name_hash) { return -1; }
+	if (source1->name_hash > source2->name_hash) { return  1; }
+	uint32_t const length = min_u32(source1->name.length, source2->name.length);
+	for (uint32_t i = 0; i < length; i++) {
+		if (source1->name.data[i] != source2->name.data[i]) {
+			return (source1->name.data[i] < source2->name.data[i]) ? -1 : 1;
+		}
+	}
+	if (source1->name.length != source2->name.length) {
+		return (source1->name.length < source2->name.length) ? -1 : 1;
+	}
+	return 0;
+}
+
+static uint64_t system_packs_write_padding(struct File * file, uint64_t position) {
+	static uint8_t const padding[PACK_ALIGNMENT] = {0};
+	uint64_t const aligned = (position + PACK_ALIGNMENT - 1) & ~(uint64_t)(PACK_ALIGNMENT - 1);
+	platform_file_write(file, (uint8_t *)(size_t)padding, aligned - position);
+	return aligned;
+}
+
+bool system_packs_write(struct CString path, struct Array const * names) {
+	bool success = false;
+
+	// @note: the index is sorted by hash, then by name, to be binary searched
+	struct Array sources = array_init(sizeof(struct Pack_Source));
+	array_resize(&sources, names->count);
+	FOR_ARRAY(names, it) {
+		struct CString const * name = it.value;
+		array_push_many(&sources, 1, &(struct Pack_Source){
+			.name_hash = hash_u32_fnv1((uint8_t const *)name->data, name->length),
+			.name = *name,
+		});
+	}
+	common_qsort(sources.data, sources.count, sources.value_size, pack_source_compare);
+
+	struct Array entries = array_init(sizeof(struct Pack_Entry));
+	array_resize(&entries, sources.count);
+
+	uint64_t const names_offset = sizeof(struct Pack_Header) + sources.count * sizeof(struct Pack_Entry);
+	uint64_t names_size = 0;
+	FOR_ARRAY(&sources, it) {
+		struct Pack_Source const * source = it.value;
+		array_push_many(&entries, 1, &(struct Pack_Entry){
+			.name_hash = source->name_hash,
+			.name_length = source->name.length,
+			.name_offset = names_offset + names_size,
+		});
+		names_size += source->name.length;
+	}
+
+	struct File * file = platform_file_init(path, FILE_MODE_WRITE | FILE_MODE_FORCE);
+	if (file == NULL) { goto finalize; }
+
+	// payloads
+	uint64_t position = names_offset + names_size;
+	platform_file_position_set(file, position);
+	FOR_ARRAY(&sources, it) {
+		struct Pack_Source const * source = it.value;
+		struct Pack_Entry * entry = array_at(&entries, it.curr);
+
+		// @note: an empty entry would shadow the loose file, fail instead
+		struct Buffer file_buffer = platform_file_read_entire(source->name);
+		if (file_buffer.capacity == 0) {
+			WRN("can't read \"%.*s\"", source->name.length, source->name.data);
+			platform_file_free(file);
+			platform_file_delete(path);
+			goto finalize;
+		}
+
+		position = system_packs_write_padding(file, position);
+		entry->offset = position;
+		entry->size = file_buffer.size;
+		entry->content_hash = hash_u64_fnv1(file_buffer.data, file_buffer.size);
+
+		position += platform_file_write(file, file_buffer.data, file_buffer.size);
+		position += platform_file_write(file, (uint8_t *)"\0", 1);
+		buffer_free(&file_buffer);
+	}
+	platform_file_end(file);
+
+	// index
+	struct Pack_Header header = {
+		.magic = PACK_MAGIC,
+		.version = PACK_VERSION,
+		.count = entries.count,
+		.alignment = PACK_ALIGNMENT,
+	};
+	platform_file_position_set(file, 0);
+	platform_file_write(file, (uint8_t *)&header, sizeof(header));
+	platform_file_write(file, entries.data, entries.count * entries.value_size);
+	FOR_ARRAY(&sources, it) {
+		struct Pack_Source const * source = it.value;
+		platform_file_write(file, (uint8_t *)(size_t)source->name.data, source->name.length);
+	}
+
+	platform_file_free(file);
+	success = true;
+
+	finalize:
+	array_free(&entries);
+	array_free(&sources);
+	return success;
+}
+
+#undef PACK_MAGIC
+#undef PACK_VERSION
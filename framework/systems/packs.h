@@ -0,0 +1,29 @@
+#if !defined(FRAMEWORK_SYSTEMS_PACKS)
+#define FRAMEWORK_SYSTEMS_PACKS
+
+#include "framework/containers/buffer.h"
+
+struct Array;
+
+// @note: a pack is a single file with an index of names, sorted by hash,
+//        and payloads, aligned to `PACK_ALIGNMENT` and null-terminated
+#define PACK_ALIGNMENT 64
+
+void system_packs_init(void);
+void system_packs_free(void);
+
+// @note: mount before loading; lookups are read-only, thus thread-safe;
+//        later mounts take precedence
+bool system_packs_mount(struct CString path);
+
+// @note: a view into a mounted pack, valid until `system_packs_free`
+struct CBuffer system_packs_find(struct CString name);
+
+// @note: a mounted entry or else the loose file; views have no `allocate`,
+//        thus are left untouched by `buffer_free`
+struct Buffer system_packs_read(struct CString name);
+
+// @note: `names` are `struct CString`, read as loose files
+bool system_packs_write(struct CString path, struct Array const * names);
+
+#endif
@@ -1,5 +1,7 @@
+#include "framework/maths.h"
 #include "framework/containers/array.h"
 #include "framework/containers/buffer.h"
+#include "framework/containers/typed.h"
 
 //
 #include "strings.h"
@@ -7,10 +9,15 @@
 static struct Strings {
 	struct Array offsets; // `uint32_t`
 	struct Array lengths; // `uint32_t`
+	struct Array hashes;  // `uint32_t`
 	struct Buffer buffer; // null-terminated chunks
+	struct Array table;   // `uint32_t`; string `id` or zero, open addressing over `hashes`
 	struct Handle h_free; // tracks generations
 } gs_strings;
 
+static uint32_t system_strings_find_slot(struct CString value, uint32_t hash);
+static void system_strings_ensure_table(uint32_t count);
+
 void system_strings_init(void) {
 	gs_strings = (struct Strings){
 		.offsets = {
@@ -19,27 +26,47 @@ void system_strings_init(void) {
 		.lengths = {
 			.value_size = sizeof(uint32_t),
 		},
+		.hashes = {
+			.value_size = sizeof(uint32_t),
+		},
+		.table = {
+			.value_size = sizeof(uint32_t),
+		},
 	};
 }
 
 void system_strings_free(void) {
 	array_free(&gs_strings.offsets);
 	array_free(&gs_strings.lengths);
+	array_free(&gs_strings.hashes);
 	buffer_free(&gs_strings.buffer);
+	array_free(&gs_strings.table);
 	gs_strings.h_free.gen++;
 }
 
 struct Handle system_strings_add(struct CString value) {
-	struct Handle handle = system_strings_find(value);
-	if (!handle_is_null(handle)) { return handle; }
+	if (cstring_empty(value)) { return (struct Handle){0}; }
+	system_strings_ensure_table(gs_strings.lengths.count + 1);
+
+	uint32_t const hash = hash_u32_fnv1((uint8_t const *)value.data, value.length);
+	uint32_t const slot = system_strings_find_slot(value, hash);
+	uint32_t * entry = array_u32_at_unsafe(&gs_strings.table, slot);
+	if (*entry != 0) {
+		return (struct Handle){
+			.id = *entry,
+			.gen = gs_strings.h_free.gen,
+		};
+	}
 
 	uint32_t const offset = (uint32_t)gs_strings.buffer.size;
-	array_push_many(&gs_strings.offsets, 1, &offset);
-	array_push_many(&gs_strings.lengths, 1, &value.length);
+	array_u32_push(&gs_strings.offsets, offset);
+	array_u32_push(&gs_strings.lengths, value.length);
+	array_u32_push(&gs_strings.hashes,  hash);
 	buffer_push_many(&gs_strings.buffer, value.length, value.data);
 	buffer_push_many(&gs_strings.buffer, 1, "\0");
 
 	uint32_t const id = gs_strings.lengths.count;
+	*entry = id;
 	return (struct Handle){
 		.id = id,
 		.gen = gs_strings.h_free.gen,
@@ -48,21 +75,17 @@ struct Handle system_strings_add(struct CString value) {
 
 struct Handle system_strings_find(struct CString value) {
 	if (cstring_empty(value)) { return (struct Handle){0}; }
-	uint32_t offset = 0;
-	FOR_ARRAY(&gs_strings.lengths, it) {
-		struct CString const word = {
-			.length = *(uint32_t *)it.value,
-			.data = buffer_at(&gs_strings.buffer, offset),
-		};
-		if (cstring_equals(word, value)) {
-			return (struct Handle){
-				.id = it.curr + 1,
-				.gen = gs_strings.h_free.gen,
-			};
-		}
-		offset += word.length + 1;
-	}
-	return (struct Handle){0};
+	if (gs_strings.table.count == 0) { return (struct Handle){0}; }
+
+	uint32_t const hash = hash_u32_fnv1((uint8_t const *)value.data, value.length);
+	uint32_t const slot = system_strings_find_slot(value, hash);
+	uint32_t const * entry = array_u32_at_unsafe(&gs_strings.table, slot);
+	if (*entry == 0) { return (struct Handle){0}; }
+
+	return (struct Handle){
+		.id = *entry,
+		.gen = gs_strings.h_free.gen,
+	};
 }
 
 struct CString system_strings_get(struct Handle handle) {
@@ -71,9 +94,61 @@ struct CString system_strings_get(struct Handle handle) {
 	if (handle.gen != gs_strings.h_free.gen)  { REPORT_CALLSTACK(); DEBUG_BREAK(); return (struct CString){0}; }
 
 	uint32_t const id = handle.id - 1;
-	uint32_t const * offset_at = array_at_unsafe(&gs_strings.offsets, id);
+	uint32_t const * offset_at = array_u32_at_unsafe(&gs_strings.offsets, id);
 	return (struct CString){
-		.length = *(uint32_t *)array_at_unsafe(&gs_strings.lengths, id),
+		.length = *array_u32_at_unsafe(&gs_strings.lengths, id),
 		.data = buffer_at_unsafe(&gs_strings.buffer, *offset_at),
 	};
 }
+
+//
+
+static uint32_t system_strings_find_slot(struct CString value, uint32_t hash) {
+	// @note: the table is never full, see `system_strings_ensure_table`
+	uint32_t const capacity = gs_strings.table.count;
+	uint32_t const offset = hash & (capacity - 1);
+	for (uint32_t i = 0; i < capacity; i++) {
+		uint32_t const slot = (i + offset) & (capacity - 1);
+		uint32_t const * entry = array_u32_at_unsafe(&gs_strings.table, slot);
+		if (*entry == 0) { return slot; }
+
+		uint32_t const id = *entry - 1;
+		uint32_t const * entry_hash = array_u32_at_unsafe(&gs_strings.hashes, id);
+		if (*entry_hash != hash) { continue; }
+
+		uint32_t const * offset_at = array_u32_at_unsafe(&gs_strings.offsets, id);
+		struct CString const word = {
+			.length = *array_u32_at_unsafe(&gs_strings.lengths, id),
+			.data = buffer_at_unsafe(&gs_strings.buffer, *offset_at),
+		};
+		if (cstring_equals(word, value)) { return slot; }
+	}
+
+	REPORT_CALLSTACK(); DEBUG_BREAK();
+	return INDEX_EMPTY;
+}
+
+static void system_strings_ensure_table(uint32_t count) {
+	// @note: keep load factor at 2/3 at most, same as `struct Hashmap`
+	uint32_t const capacity = gs_strings.table.count;
+	if (count <= mul_div_u32(capacity, 2, 3)) { return; }
+
+	uint32_t const target = po2_next_u32(max_u32(capacity * 2, 8));
+	array_resize(&gs_strings.table, target);
+	gs_strings.table.count = target;
+	cbuffer_clear((struct CBuffer_Mut){
+		.size = sizeof(uint32_t) * target,
+		.data = gs_strings.table.data,
+	});
+
+	uint32_t const mask = target - 1;
+	FOR_ARRAY(&gs_strings.hashes, it) {
+		uint32_t const * hash = it.value;
+		uint32_t slot = *hash & mask;
+		for (;; slot = (slot + 1) & mask) {
+			uint32_t const * entry = array_u32_at_unsafe(&gs_strings.table, slot);
+			if (*entry == 0) { break; }
+		}
+		*array_u32_at_unsafe(&gs_strings.table, slot) = it.curr + 1;
+	}
+}
@@ -0,0 +1,56 @@
+// unity build
+#include "framework/common.c"
+#include "framework/maths.c"
+#include "framework/formatter.c"
+#include "framework/parsing.c"
+#include "framework/json_read.c"
+
+
+
+
+#include "framework/platform/allocator.c"
+#if defined(_WIN32) || defined(_WIN64)
+	#include "framework/platform/windows/memory.c"
+	#include "framework/platform/windows/timer.c"
+	#include "framework/platform/windows/file.c"
+	#include "framework/platform/windows/debug.c"
+	#include "framework/platform/windows/thread.c"
+#endif
+
+
+
+
+#include "framework/containers/internal/helpers.c"
+#include "framework/containers/array.c"
+#include "framework/containers/buffer.c"
+#include "framework/containers/hashmap.c"
+#include "framework/containers/dictionary.c"
+#include "framework/containers/sparseset.c"
+#include "framework/containers/smallarray.c"
+
+#include "framework/systems/memory.c"
+#include "framework/systems/jobs.c"
+#include "framework/systems/packs.c"
+#include "framework/systems/strings.c"
+#include "framework/systems/assets.c"
+
+#include "framework/graphics/gfx_types.c"
+
+#include "framework/assets/image.c"
+#include "framework/assets/typeface.c"
+#include "framework/assets/font.c"
+#include "framework/assets/internal/wfobj_lexer.c"
+#include "framework/assets/internal/json_lexer.c"
+#include "framework/assets/internal/wfobj.c"
+#include "framework/assets/json.c"
+#include "framework/assets/mesh.c"
+
+#include "application/json_preload.c"
+
+#include "tools/bench_hashmap.c"
+#include "tools/bench_strings.c"
+#include "tools/bench_font.c"
+#include "tools/bench_memory.c"
+#include "tools/bench_assets.c"
+#include "tools/bench_scene.c"
+#include "tools/bench.c"
@@ -0,0 +1,37 @@
+// unity build
+#include "framework/common.c"
+#include "framework/maths.c"
+#include "framework/formatter.c"
+#include "framework/parsing.c"
+
+
+
+
+#include "framework/platform/allocator.c"
+#if defined(_WIN32) || defined(_WIN64)
+	#include "framework/platform/windows/memory.c"
+	#include "framework/platform/windows/timer.c"
+	#include "framework/platform/windows/file.c"
+	#include "framework/platform/windows/debug.c"
+	#include "framework/platform/windows/thread.c"
+#endif
+
+
+
+
+#include "framework/containers/internal/helpers.c"
+#include "framework/containers/array.c"
+#include "framework/containers/buffer.c"
+#include "framework/containers/hashmap.c"
+
+#include "framework/systems/memory.c"
+
+#include "framework/graphics/gfx_types.c"
+
+#include "framework/assets/internal/wfobj_lexer.c"
+#include "framework/assets/internal/wfobj.c"
+#include "framework/assets/mesh.c"
+#include "framework/assets/image.c"
+#include "framework/assets/cooked.c"
+
+#include "tools/cooker.c"
@@ -15,11 +15,13 @@
 #include "framework/platform/allocator.c"
 #define GAME_GRAPHICS_IS_OPENGL
 #if defined(_WIN32) || defined(_WIN64)
+	#include "framework/platform/windows/memory.c"
 	#include "framework/platform/windows/timer.c"
 	#include "framework/platform/windows/file.c"
 	#include "framework/platform/windows/system.c"
 	#include "framework/platform/windows/window.c"
 	#include "framework/platform/windows/debug.c"
+	#include "framework/platform/windows/thread.c"
 
 	#if defined(GAME_GRAPHICS_IS_OPENGL)
 		#include "framework/platform/windows/gpu_library_opengl.c"
@@ -36,10 +38,14 @@
 #include "framework/containers/array.c"
 #include "framework/containers/buffer.c"
 #include "framework/containers/hashmap.c"
+#include "framework/containers/dictionary.c"
 #include "framework/containers/sparseset.c"
+#include "framework/containers/smallarray.c"
 
 #include "framework/systems/memory.c"
 #include "framework/systems/defer.c"
+#include "framework/systems/jobs.c"
+#include "framework/systems/packs.c"
 #include "framework/systems/strings.c"
 #include "framework/systems/materials.c"
 #include "framework/systems/assets.c"
@@ -56,8 +62,10 @@
 #include "framework/assets/image.c"
 #include "framework/assets/typeface.c"
 #include "framework/assets/font.c"
+#include "framework/assets/cooked.c"
 
 #include "application/json_load.c"
+#include "application/json_preload.c"
 #include "application/application.c"
 #include "application/asset_types.c"
 #include "application/app_components.c"
@@ -7,6 +7,7 @@
 #include "framework/assets/json.h"
 
 #include "application/json_load.h"
+#include "application/json_preload.h"
 #include "application/asset_types.h"
 
 #include "proto_components.h"
@@ -219,6 +220,16 @@ JSON_PROCESSOR(game_fill_scene) {
 	if (json->type == JSON_ERROR) { REPORT_CALLSTACK(); DEBUG_BREAK(); return; }
 	if (data != &gs_game)         { REPORT_CALLSTACK(); DEBUG_BREAK(); return; }
 
+	// @note: assets are prepared in the background, while entities pick them up
+	struct Array preload = array_init(sizeof(struct Handle));
+	json_load_preload(json, &preload);
+
 	json_read_cameras(json_get(json, S_("cameras")));
 	json_read_entities(json_get(json, S_("entities")));
+
+	FOR_ARRAY(&preload, it) {
+		struct Handle const * ah_asset = it.value;
+		system_assets_drop(*ah_asset);
+	}
+	array_free(&preload);
 }
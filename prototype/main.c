@@ -9,6 +9,7 @@
 #include "framework/formatter.h"
 
 #include "framework/platform/system.h"
+#include "framework/platform/timer.h"
 #include "framework/platform/file.h"
 #include "framework/containers/hashmap.h"
 
@@ -17,6 +18,8 @@
 #include "framework/systems/defer.h"
 #include "framework/systems/materials.h"
 #include "framework/systems/assets.h"
+#include "framework/systems/jobs.h"
+#include "framework/systems/packs.h"
 
 #include "framework/graphics/gfx_material.h"
 #include "framework/graphics/gfx_objects.h"
@@ -161,8 +164,10 @@ static void prototype_init(void) {
 		return;
 	}
 
+	uint64_t const ticks = platform_timer_get_ticks();
 	struct CString const scene_path = system_strings_get(gs_main_settings.sh_scene);
 	process_json(scene_path, &gs_game, game_fill_scene);
+	TRC("scene loaded in %.3f ms", platform_timer_get_millis(platform_timer_get_ticks() - ticks));
 	gpu_execute(1, &(struct GPU_Command){
 		.type = GPU_COMMAND_TYPE_CULL,
 		.as.cull = {
@@ -435,6 +440,20 @@ static void prototype_draw_ui(void) {
 
 static void app_init(void) {
 	renderer_init();
+	renderer_reserve((struct Renderer_Capacity){
+		.gpu_commands  = 256,
+		.uniforms      = 64,
+		.uniforms_size = 64 * sizeof(struct mat4),
+		.global_size   = 256,
+		.camera_size   = 4 * (1 << 10),
+		.batcher_2d = {
+			.quads         = 4096,
+			.codepoints    = 4096,
+			.batches       = 64,
+			.uniforms      = 64,
+			.uniforms_size = 4 * (1 << 10),
+		},
+	});
 	game_init();
 	ui_init();
 	prototype_init();
@@ -504,17 +523,24 @@ static JSON_PROCESSOR(main_fill_config) {
 	result->vsync               = (int32_t)json_get_number(json, S_("vsync"));
 	result->target_refresh_rate = (uint32_t)json_get_number(json, S_("target_refresh_rate"));
 	result->fixed_refresh_rate  = (uint32_t)json_get_number(json, S_("fixed_refresh_rate"));
+	result->memory_telemetry = json_get_boolean(json, S_("memory_telemetry"));
+	result->allocations_warmup = (uint32_t)json_get_number(json, S_("allocations_warmup"));
 }
 
 static void main_system_init(void) {
+	system_memory_pool_init();
 	system_assets_init();
 	system_materials_init();
 	system_defer_init();
 	system_strings_init();
 	system_memory_arena_init();
+	system_memory_frame_init();
 	system_memory_debug_init();
+	system_jobs_init(0);
+	system_packs_init();
 
 	system_memory_arena_ensure((64 + 32) * (1 << 10));
+	system_memory_frame_ensure(256 * (1 << 10));
 	platform_system_init((struct Platform_Callbacks){
 		.quit = app_platform_quit,
 	});
@@ -522,18 +548,26 @@ static void main_system_init(void) {
 
 static void main_system_free(void) {
 	system_assets_free();
+	system_jobs_free();
+	system_packs_free();
 	system_materials_free();
 	system_defer_free();
 	system_strings_free();
 	system_memory_arena_free();
+	system_memory_frame_free();
 	system_memory_debug_free();
 
 	platform_system_free();
+	system_memory_pool_free();
 }
 
 static void main_run_application(void) {
 	asset_types_map();
 	asset_types_set();
+	system_assets_type_freeze();
+
+	// @note: optional, the loose files are a fallback
+	system_packs_mount(S_("assets.pack"));
 
 	process_json(S_("assets/main.json"), &gs_main_settings, main_fill_settings);
 	if (handle_is_null(gs_main_settings.sh_config)) { return; }
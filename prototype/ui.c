@@ -1,6 +1,5 @@
 #include "framework/maths.h"
 
-#include "framework/systems/defer.h"
 #include "framework/systems/assets.h"
 #include "framework/systems/materials.h"
 
@@ -106,30 +105,21 @@ void ui_set_color(struct vec4 color) {
 }
 
 void ui_set_shader(struct CString name) {
-	system_defer_push((struct Action){
-		.frames = 1,
-		.handle = gs_ui.ah_shader,
-		.invoke = system_assets_drop,
-	});
+	struct Handle const ah_shader = gs_ui.ah_shader;
 	gs_ui.ah_shader = system_assets_load(name);
+	system_assets_drop(ah_shader);
 }
 
 void ui_set_image(struct CString name) {
-	system_defer_push((struct Action){
-		.frames = 1,
-		.handle = gs_ui.ah_image,
-		.invoke = system_assets_drop,
-	});
+	struct Handle const ah_image = gs_ui.ah_image;
 	gs_ui.ah_image = system_assets_load(name);
+	system_assets_drop(ah_image);
 }
 
 void ui_set_font(struct CString name) {
-	system_defer_push((struct Action){
-		.frames = 1,
-		.handle = gs_ui.ah_font,
-		.invoke = system_assets_drop,
-	});
+	struct Handle const ah_font = gs_ui.ah_font;
 	gs_ui.ah_font = system_assets_load(name);
+	system_assets_drop(ah_font);
 }
 
 void ui_quad(struct rect uv) {
@@ -0,0 +1,21 @@
+#if !defined(TOOLS_ARGUMENTS)
+#define TOOLS_ARGUMENTS
+
+#include "framework/common.h"
+
+inline static struct CString arguments_get(char const * value) {
+	return (struct CString){
+		.length = find_null(value),
+		.data = value,
+	};
+}
+
+// @note: skips the next argument if it is the `flag`
+inline static bool arguments_take_flag(int argc, char * argv[], int * arg_i, struct CString flag) {
+	if (*arg_i >= argc) { return false; }
+	if (!cstring_equals(flag, arguments_get(argv[*arg_i]))) { return false; }
+	(*arg_i)++;
+	return true;
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "framework/formatter.h"
+
+#include "framework/systems/memory.h"
+
+#include "tools/arguments.h"
+
+
+//
+#include "bench.h"
+
+// @note: usage
+//        `bench`           runs every bench
+//        `bench <name>...` runs the named ones
+//        exits with `1` if any check fails
+
+static struct Bench_Entry {
+	struct CString name;
+	Bench * run;
+} const gs_bench_entries[] = {
+	{S__("hashmap_probe"),  bench_hashmap_probe},
+	{S__("hashmap_clear"),  bench_hashmap_clear},
+	{S__("hashmap_frozen"), bench_hashmap_frozen},
+	{S__("strings_lookup"), bench_strings_lookup},
+	{S__("font_glyphs"),    bench_font_glyphs},
+	{S__("memory_arena"),   bench_memory_arena},
+	{S__("memory_pool"),    bench_memory_pool},
+	{S__("memory_threads"), bench_memory_threads},
+	{S__("memory_virtual"), bench_memory_virtual},
+	{S__("assets_budget"),  bench_assets_budget},
+	{S__("scene_preload"),  bench_scene_preload},
+};
+
+static bool bench_run(struct Bench_Entry const * entry) {
+	LOG("[%.*s]\n", entry->name.length, entry->name.data);
+	bool const result = entry->run();
+	if (!result) { ERR("failure: \"%.*s\"", entry->name.length, entry->name.data); }
+	LOG("\n");
+	return result;
+}
+
+int main (int argc, char * argv[]) {
+	system_memory_pool_init();
+	system_memory_arena_init();
+	system_memory_debug_init();
+
+	uint32_t const entries_count = SIZE_OF_ARRAY(gs_bench_entries);
+
+	int result = 0;
+	if (argc < 2) {
+		for (uint32_t i = 0; i < entries_count; i++) {
+			if (!bench_run(gs_bench_entries + i)) { result = 1; }
+		}
+	}
+	for (int arg_i = 1; arg_i < argc; arg_i++) {
+		struct CString const name = arguments_get(argv[arg_i]);
+
+		struct Bench_Entry const * entry = NULL;
+		for (uint32_t i = 0; i < entries_count; i++) {
+			if (!cstring_equals(gs_bench_entries[i].name, name)) { continue; }
+			entry = gs_bench_entries + i;
+			break;
+		}
+
+		if (entry == NULL) { WRN("unknown bench \"%.*s\"", name.length, name.data); result = 1; continue; }
+		if (!bench_run(entry)) { result = 1; }
+	}
+
+	system_memory_debug_free();
+	system_memory_arena_free();
+	system_memory_pool_free();
+	return result;
+}
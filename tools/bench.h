@@ -0,0 +1,22 @@
+#if !defined(TOOLS_BENCH)
+#define TOOLS_BENCH
+
+#include "framework/common.h"
+
+// @note: a bench logs its own numbers; `false` means a check has failed
+#define BENCH(func) bool (func)(void)
+typedef BENCH(Bench);
+
+BENCH(bench_hashmap_probe);
+BENCH(bench_hashmap_clear);
+BENCH(bench_hashmap_frozen);
+BENCH(bench_strings_lookup);
+BENCH(bench_font_glyphs);
+BENCH(bench_memory_arena);
+BENCH(bench_memory_pool);
+BENCH(bench_memory_threads);
+BENCH(bench_memory_virtual);
+BENCH(bench_assets_budget);
+BENCH(bench_scene_preload);
+
+#endif
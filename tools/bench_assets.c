@@ -0,0 +1,132 @@
+#include "framework/formatter.h"
+#include "framework/maths.h"
+
+#include "framework/platform/timer.h"
+#include "framework/systems/memory.h"
+#include "framework/systems/strings.h"
+#include "framework/systems/jobs.h"
+#include "framework/systems/assets.h"
+
+
+//
+#include "bench.h"
+
+// @note: a camera pans back and forth over a row of assets, the way
+//        `application_update` sees them: loads are asynchronous, the previous
+//        frame's are dropped, and the sync point finalizes and trims caches
+
+struct Bench_Assets_Blob {
+	uint32_t bytes;
+};
+
+static struct Bench_Assets {
+	uint32_t loads, drops;
+} gs_bench_assets;
+
+static ASSET_PREPARE(bench_assets_blob_prepare) {
+	uint32_t * result = ALLOCATE(uint32_t);
+	*result = (16 << 10) * (1 + hash_u32_fnv1((uint8_t const *)name.data, name.length) % 4);
+	return result;
+}
+
+static HANDLE_ACTION(bench_assets_blob_load) {
+	struct Bench_Assets_Blob * asset = system_assets_get(handle);
+	uint32_t * staged = system_assets_get_staged(handle);
+	*asset = (struct Bench_Assets_Blob){
+		.bytes = (staged != NULL) ? *staged : 0,
+	};
+	FREE(staged);
+	gs_bench_assets.loads++;
+}
+
+static HANDLE_ACTION(bench_assets_blob_drop) {
+	struct Bench_Assets_Blob * asset = system_assets_get(handle);
+	cbuffer_clear(CBMP_(asset));
+	gs_bench_assets.drops++;
+}
+
+static ASSET_MEASURE(bench_assets_blob_measure) {
+	struct Bench_Assets_Blob const * asset = system_assets_get(handle);
+	return (asset != NULL) ? asset->bytes : 0;
+}
+
+static struct Handle bench_assets_load(uint32_t index) {
+	char name[32];
+	uint32_t const length = formatter_fmt(SIZE_OF_ARRAY(name), name, "budget/%u.blob", index);
+	return system_assets_load_async((struct CString){.length = length, .data = name});
+}
+
+BENCH(bench_assets_budget) {
+	uint32_t const count   = 64;  // assets in the row
+	uint32_t const visible = 8;   // assets in view
+	uint32_t const frames  = 2048;
+	uint32_t const step    = 4;   // frames per asset panned
+	uint64_t const budget  = 512 << 10;
+
+	gs_bench_assets = (struct Bench_Assets){0};
+	system_strings_init();
+	system_assets_init();
+	system_jobs_init(0);
+
+	system_assets_type_map(S_("blob"), S_("blob"));
+	system_assets_type_set(S_("blob"), (struct Asset_Info){
+		.size = sizeof(struct Bench_Assets_Blob),
+		.budget = budget,
+		.prepare = bench_assets_blob_prepare,
+		.load = bench_assets_blob_load,
+		.drop = bench_assets_blob_drop,
+		.measure = bench_assets_blob_measure,
+	});
+
+	struct Handle * handles_prev = ALLOCATE_ARRAY(struct Handle, visible);
+	struct Handle * handles_next = ALLOCATE_ARRAY(struct Handle, visible);
+	for (uint32_t i = 0; i < visible; i++) { handles_prev[i] = (struct Handle){0}; }
+
+	bool result = true;
+	uint64_t bytes_peak = 0, ticks_sync = 0, ticks_sync_max = 0;
+	uint32_t const span = count - visible;
+	for (uint32_t frame = 0; frame < frames; frame++) {
+		uint32_t const pan = (frame / step) % (span * 2);
+		uint32_t const first = (pan < span) ? pan : span * 2 - pan;
+		for (uint32_t i = 0; i < visible; i++) {
+			handles_next[i] = bench_assets_load(first + i);
+		}
+		for (uint32_t i = 0; i < visible; i++) {
+			system_assets_drop(handles_prev[i]);
+		}
+		struct Handle * handles_swap = handles_prev;
+		handles_prev = handles_next; handles_next = handles_swap;
+
+		uint64_t const ticks = platform_timer_get_ticks();
+		system_assets_sync();
+		uint64_t const elapsed = platform_timer_get_ticks() - ticks;
+		ticks_sync += elapsed;
+		if (ticks_sync_max < elapsed) { ticks_sync_max = elapsed; }
+
+		struct Asset_Cache_Stats const stats = system_assets_get_cache_stats(S_("blob"));
+		if (stats.bytes > budget) { result = false; }
+		if (bytes_peak < stats.bytes) { bytes_peak = stats.bytes; }
+	}
+
+	struct Asset_Cache_Stats const stats = system_assets_get_cache_stats(S_("blob"));
+	if (stats.evictions == 0 || stats.hits == 0) { result = false; }
+
+	for (uint32_t i = 0; i < visible; i++) {
+		system_assets_drop(handles_prev[i]);
+	}
+	system_assets_flush();
+	if (gs_bench_assets.loads != gs_bench_assets.drops) { result = false; }
+
+	LOG("%u assets, %u in view, %u frames, budget %u KiB: %s\n", count, visible, frames, (uint32_t)(budget >> 10), result ? "valid" : "INVALID");
+	LOG("  %-10s %8u hits, %6u misses, %6u evictions\n", "cache", (uint32_t)stats.hits, (uint32_t)stats.misses, (uint32_t)stats.evictions);
+	LOG("  %-10s %8u KiB peak, %6u loads, %6u drops\n", "resident", (uint32_t)(bytes_peak >> 10), gs_bench_assets.loads, gs_bench_assets.drops);
+	LOG("  %-10s %8.3f us average, %8.3f us max\n", "sync", platform_timer_get_millis(ticks_sync) * 1000.0 / (double)frames, platform_timer_get_millis(ticks_sync_max) * 1000.0);
+
+	FREE(handles_prev);
+	FREE(handles_next);
+	system_assets_type_del(S_("blob"));
+	system_assets_free();
+	system_jobs_free();
+	system_strings_free();
+	return result;
+}
@@ -0,0 +1,95 @@
+#include "framework/formatter.h"
+#include "framework/maths.h"
+
+#include "framework/platform/timer.h"
+#include "framework/platform/file.h"
+#include "framework/containers/buffer.h"
+#include "framework/systems/memory.h"
+
+#include "framework/assets/typeface.h"
+#include "framework/assets/font.h"
+
+
+//
+#include "bench.h"
+
+// @note: a text block the way `batcher_2d_add_text` sees it: a stream of
+//        codepoints, resolved either one by one or in a single batch
+
+static uint32_t bench_font_get_codepoint(uint32_t index) {
+	// @note: mostly ASCII, with a sprinkle of Latin-1 and Latin Extended-A
+	uint32_t const value = hash_u32_xorshift(index + 1);
+	if (value % 8 != 0) { return 0x20 + (value >> 8) % (0x7f - 0x20); }
+	return 0xa0 + (value >> 8) % (0x180 - 0xa0);
+}
+
+static uint64_t bench_font_get_one(struct Font * font, uint32_t count, uint32_t const * codepoints, float size, struct Glyph const ** glyphs) {
+	uint64_t const ticks = platform_timer_get_ticks();
+	for (uint32_t i = 0; i < count; i++) {
+		glyphs[i] = font_get_glyph(font, codepoints[i], size);
+	}
+	return platform_timer_get_ticks() - ticks;
+}
+
+static uint64_t bench_font_get_many(struct Font * font, uint32_t count, uint32_t const * codepoints, float size, struct Glyph const ** glyphs) {
+	uint64_t const ticks = platform_timer_get_ticks();
+	font_get_glyphs(font, count, codepoints, size, glyphs);
+	return platform_timer_get_ticks() - ticks;
+}
+
+BENCH(bench_font_glyphs) {
+	struct CString const path = S_("assets/typefaces/Ubuntu-Regular.ttf");
+	struct Buffer source = platform_file_read_entire(path);
+	if (source.capacity == 0) {
+		WRN("can't read \"%.*s\", run from the project root", path.length, path.data);
+		return false;
+	}
+
+	uint32_t const count  = 10000;
+	uint32_t const rounds = 201;
+	float const sizes[] = {12, 16, 24, 32};
+
+	struct Typeface * typeface = typeface_init(&source);
+	struct Font * font = font_init();
+	font_set_typeface(font, typeface, 0, UINT32_MAX);
+
+	uint32_t * codepoints = ALLOCATE_ARRAY(uint32_t, count);
+	struct Glyph const ** glyphs_one  = ALLOCATE_ARRAY(struct Glyph const *, count);
+	struct Glyph const ** glyphs_many = ALLOCATE_ARRAY(struct Glyph const *, count);
+	for (uint32_t i = 0; i < count; i++) {
+		codepoints[i] = bench_font_get_codepoint(i);
+	}
+	for (uint32_t size_i = 0; size_i < SIZE_OF_ARRAY(sizes); size_i++) {
+		for (uint32_t i = 0; i < count; i++) {
+			font_add_glyph(font, codepoints[i], sizes[size_i]);
+		}
+	}
+
+	// @note: rounds alternate, so that neither way benefits from a warm cache alone
+	bool result = true;
+	uint64_t best_one = UINT64_MAX, best_many = UINT64_MAX;
+	for (uint32_t round = 0; round < rounds; round++) {
+		uint64_t one = 0, many = 0;
+		for (uint32_t size_i = 0; size_i < SIZE_OF_ARRAY(sizes); size_i++) {
+			one  += bench_font_get_one (font, count, codepoints, sizes[size_i], glyphs_one);
+			many += bench_font_get_many(font, count, codepoints, sizes[size_i], glyphs_many);
+			for (uint32_t i = 0; i < count; i++) {
+				if (glyphs_one[i] == NULL || glyphs_one[i] != glyphs_many[i]) { result = false; }
+			}
+		}
+		if (best_one  > one)  { best_one  = one; }
+		if (best_many > many) { best_many = many; }
+	}
+
+	uint32_t const lookups = count * (uint32_t)SIZE_OF_ARRAY(sizes);
+	LOG("%u codepoints, %u sizes, best of %u rounds: %s\n", count, (uint32_t)SIZE_OF_ARRAY(sizes), rounds, result ? "valid" : "INVALID");
+	LOG("  %-10s %8.3f us, %6.2f ns per glyph\n", "one", platform_timer_get_millis(best_one)  * 1000.0, platform_timer_get_millis(best_one)  * 1000000.0 / (double)lookups);
+	LOG("  %-10s %8.3f us, %6.2f ns per glyph\n", "many", platform_timer_get_millis(best_many) * 1000.0, platform_timer_get_millis(best_many) * 1000000.0 / (double)lookups);
+
+	FREE(codepoints);
+	FREE(glyphs_one);
+	FREE(glyphs_many);
+	font_free(font);
+	typeface_free(typeface);
+	return result;
+}
@@ -0,0 +1,338 @@
+#include "framework/formatter.h"
+#include "framework/maths.h"
+
+#include "framework/platform/timer.h"
+#include "framework/containers/hashmap.h"
+#include "framework/systems/memory.h"
+
+
+//
+#include "bench.h"
+
+// @note: the layout hashmaps had before group probing: separate `marks`,
+//        `hashes` and `keys`, probed one slot at a time; hashing and comparison
+//        go through the same indirections as `struct Hashmap` does
+struct Bench_Slot_Map {
+	Hasher * get_hash;
+	uint32_t capacity;
+	uint8_t  * marks;
+	uint32_t * hashes;
+	uint32_t * keys;
+	uint32_t * values;
+};
+
+static struct Bench_Slot_Map bench_slot_map_init(uint32_t capacity) {
+	struct Bench_Slot_Map result = {
+		.get_hash = hash32,
+		.capacity = capacity,
+		.marks  = ALLOCATE_ARRAY(uint8_t,  capacity),
+		.hashes = ALLOCATE_ARRAY(uint32_t, capacity),
+		.keys   = ALLOCATE_ARRAY(uint32_t, capacity),
+		.values = ALLOCATE_ARRAY(uint32_t, capacity),
+	};
+	common_memset(result.marks, 0, sizeof(*result.marks) * capacity);
+	return result;
+}
+
+static void bench_slot_map_free(struct Bench_Slot_Map * map) {
+	FREE(map->marks);
+	FREE(map->hashes);
+	FREE(map->keys);
+	FREE(map->values);
+	cbuffer_clear(CBMP_(map));
+}
+
+static uint32_t bench_slot_map_find(struct Bench_Slot_Map const * map, uint32_t key, uint32_t hash) {
+	uint32_t const mask = map->capacity - 1;
+	for (uint32_t i = 0, index = hash & mask; i < map->capacity; i++, index = (index + 1) & mask) {
+		if (map->marks[index] == 0)     { return index; }
+		if (map->hashes[index] != hash) { continue; }
+		if (equals(map->keys + index, &key, sizeof(key))) { return index; }
+	}
+	return INDEX_EMPTY;
+}
+
+static void bench_slot_map_set(struct Bench_Slot_Map * map, uint32_t key, uint32_t value) {
+	uint32_t const hash = map->get_hash(&key);
+	uint32_t const index = bench_slot_map_find(map, key, hash);
+	if (index == INDEX_EMPTY) { return; }
+	map->marks[index]  = 1;
+	map->hashes[index] = hash;
+	map->keys[index]   = key;
+	map->values[index] = value;
+}
+
+static uint32_t const * bench_slot_map_get(struct Bench_Slot_Map const * map, uint32_t key) {
+	uint32_t const index = bench_slot_map_find(map, key, map->get_hash(&key));
+	if (index == INDEX_EMPTY)     { return NULL; }
+	if (map->marks[index] == 0)   { return NULL; }
+	return map->values + index;
+}
+
+//
+
+struct Bench_Probe_Result {
+	uint64_t hit_ticks, miss_ticks;
+	bool valid;
+};
+
+static void bench_hashmap_probe_log(char const * name, uint32_t lookups, struct Bench_Probe_Result result) {
+	LOG("  %-10s hit %6.2f ns, miss %6.2f ns\n"
+		, name
+		, platform_timer_get_millis(result.hit_ticks)  * 1000000.0 / (double)lookups
+		, platform_timer_get_millis(result.miss_ticks) * 1000000.0 / (double)lookups
+	);
+}
+
+static struct Bench_Probe_Result bench_hashmap_probe_groups(
+	enum Hashmap_Flag flags, uint32_t count, uint32_t rounds,
+	uint32_t const * hits, uint32_t const * misses, uint32_t * capacity
+) {
+	struct Hashmap hashmap = hashmap_init(hash32, sizeof(uint32_t), sizeof(uint32_t));
+	hashmap.flags = flags;
+	for (uint32_t i = 0; i < count; i++) {
+		hashmap_set(&hashmap, hits + i, &i);
+	}
+	*capacity = hashmap.capacity;
+
+	struct Bench_Probe_Result result = {.valid = true};
+
+	uint64_t const hit_ticks = platform_timer_get_ticks();
+	for (uint32_t round = 0; round < rounds; round++) {
+		for (uint32_t i = 0; i < count; i++) {
+			uint32_t const * value = hashmap_get(&hashmap, hits + i);
+			if (value == NULL || *value != i) { result.valid = false; }
+		}
+	}
+	result.hit_ticks = platform_timer_get_ticks() - hit_ticks;
+
+	uint64_t const miss_ticks = platform_timer_get_ticks();
+	for (uint32_t round = 0; round < rounds; round++) {
+		for (uint32_t i = 0; i < count; i++) {
+			if (hashmap_get(&hashmap, misses + i) != NULL) { result.valid = false; }
+		}
+	}
+	result.miss_ticks = platform_timer_get_ticks() - miss_ticks;
+
+	hashmap_free(&hashmap);
+	return result;
+}
+
+static struct Bench_Probe_Result bench_hashmap_probe_slots(
+	uint32_t capacity, uint32_t count, uint32_t rounds,
+	uint32_t const * hits, uint32_t const * misses
+) {
+	struct Bench_Slot_Map map = bench_slot_map_init(capacity);
+	for (uint32_t i = 0; i < count; i++) {
+		bench_slot_map_set(&map, hits[i], i);
+	}
+
+	struct Bench_Probe_Result result = {.valid = true};
+
+	uint64_t const hit_ticks = platform_timer_get_ticks();
+	for (uint32_t round = 0; round < rounds; round++) {
+		for (uint32_t i = 0; i < count; i++) {
+			uint32_t const * value = bench_slot_map_get(&map, hits[i]);
+			if (value == NULL || *value != i) { result.valid = false; }
+		}
+	}
+	result.hit_ticks = platform_timer_get_ticks() - hit_ticks;
+
+	uint64_t const miss_ticks = platform_timer_get_ticks();
+	for (uint32_t round = 0; round < rounds; round++) {
+		for (uint32_t i = 0; i < count; i++) {
+			if (bench_slot_map_get(&map, misses[i]) != NULL) { result.valid = false; }
+		}
+	}
+	result.miss_ticks = platform_timer_get_ticks() - miss_ticks;
+
+	bench_slot_map_free(&map);
+	return result;
+}
+
+BENCH(bench_hashmap_probe) {
+	bool result = true;
+	uint32_t const counts[] = {1 << 10, 1 << 14, 1 << 18, 1 << 20};
+	for (uint32_t count_i = 0; count_i < SIZE_OF_ARRAY(counts); count_i++) {
+		uint32_t const count = counts[count_i];
+		uint32_t const rounds = max_u32((1 << 22) / count, 1);
+		uint32_t const lookups = count * rounds;
+
+		// @note: xorshift is a bijection, thus hits and misses never collide
+		uint32_t * hits   = ALLOCATE_ARRAY(uint32_t, count);
+		uint32_t * misses = ALLOCATE_ARRAY(uint32_t, count);
+		for (uint32_t i = 0; i < count; i++) {
+			hits[i]   = hash_u32_xorshift(i + 1);
+			misses[i] = hash_u32_xorshift(i + 1 + count);
+		}
+
+		uint32_t capacity = 0, packed_capacity = 0;
+		struct Bench_Probe_Result const groups = bench_hashmap_probe_groups(HASHMAP_FLAG_NONE,   count, rounds, hits, misses, &capacity);
+		struct Bench_Probe_Result const packed = bench_hashmap_probe_groups(HASHMAP_FLAG_PACKED, count, rounds, hits, misses, &packed_capacity);
+		struct Bench_Probe_Result const slots  = bench_hashmap_probe_slots(capacity, count, rounds, hits, misses);
+
+		LOG("%u keys, %u slots:\n", count, capacity);
+		bench_hashmap_probe_log("slots",  lookups, slots);
+		bench_hashmap_probe_log("groups", lookups, groups);
+		bench_hashmap_probe_log("packed", lookups, packed);
+		result = result && slots.valid && groups.valid && packed.valid;
+
+		FREE(hits);
+		FREE(misses);
+	}
+	return result;
+}
+
+//
+
+static void bench_hashmap_reserve(struct Hashmap * hashmap, uint32_t capacity) {
+	// @note: a single `hashmap_ensure` might grow just one step
+	while (hashmap->capacity < capacity) {
+		hashmap_ensure(hashmap, hashmap->capacity + 1);
+	}
+}
+
+static uint64_t bench_hashmap_clear_ticks(enum Hashmap_Flag flags, uint32_t capacity, uint32_t clears, uint32_t used) {
+	struct Hashmap hashmap = hashmap_init(hash32, sizeof(uint32_t), 0);
+	hashmap.flags = flags;
+	bench_hashmap_reserve(&hashmap, capacity);
+
+	uint64_t result = 0;
+	for (uint32_t clear = 0; clear < clears; clear++) {
+		for (uint32_t i = 0; i < used; i++) {
+			uint32_t const key = hash_u32_xorshift(clear * used + i + 1);
+			hashmap_set(&hashmap, &key, NULL);
+		}
+		uint64_t const ticks = platform_timer_get_ticks();
+		hashmap_clear(&hashmap);
+		result += platform_timer_get_ticks() - ticks;
+	}
+
+	hashmap_free(&hashmap);
+	return result;
+}
+
+BENCH(bench_hashmap_clear) {
+	uint32_t const capacity = 1 << 20;
+	uint32_t const clears   = 10000;
+	uint32_t const used     = 4;
+
+	// @note: start close to the end, so that the epoch wraps around midway
+	struct Hashmap hashmap = hashmap_init(hash32, sizeof(uint32_t), sizeof(uint32_t));
+	hashmap.flags = HASHMAP_FLAG_EPOCH;
+	bench_hashmap_reserve(&hashmap, capacity);
+	hashmap.epoch = UINT32_MAX - clears / 2;
+
+	bool result = hashmap.capacity >= capacity;
+	for (uint32_t clear = 0; clear < clears; clear++) {
+		hashmap_clear(&hashmap);
+		for (uint32_t i = 0; i < used; i++) {
+			uint32_t const key = hash_u32_xorshift(clear * used + i + 1);
+			hashmap_set(&hashmap, &key, &clear);
+		}
+
+		if (hashmap_get_count(&hashmap) != used) { result = false; }
+		for (uint32_t i = 0; i < used; i++) {
+			uint32_t const key = hash_u32_xorshift(clear * used + i + 1);
+			uint32_t const * value = hashmap_get(&hashmap, &key);
+			if (value == NULL || *value != clear) { result = false; }
+		}
+		for (uint32_t i = 0; i < used && clear > 0; i++) {
+			uint32_t const key = hash_u32_xorshift((clear - 1) * used + i + 1);
+			if (hashmap_get(&hashmap, &key) != NULL) { result = false; }
+		}
+
+		uint32_t iterated = 0;
+		FOR_HASHMAP(&hashmap, it) { iterated++; }
+		if (iterated != used) { result = false; }
+	}
+	LOG("%u clears of %u slots, %u keys each: %s\n", clears, hashmap.capacity, used, result ? "valid" : "INVALID");
+	hashmap_free(&hashmap);
+
+	uint64_t const epoch_ticks = bench_hashmap_clear_ticks(HASHMAP_FLAG_EPOCH, capacity, clears, 64);
+	uint64_t const marks_ticks = bench_hashmap_clear_ticks(HASHMAP_FLAG_NONE,  capacity, clears, 64);
+	LOG("  %-10s %8.3f ms total, %8.3f us per clear\n", "epoch", platform_timer_get_millis(epoch_ticks), platform_timer_get_millis(epoch_ticks) * 1000.0 / (double)clears);
+	LOG("  %-10s %8.3f ms total, %8.3f us per clear\n", "marks", platform_timer_get_millis(marks_ticks), platform_timer_get_millis(marks_ticks) * 1000.0 / (double)clears);
+
+	return result;
+}
+
+//
+
+static struct Bench_Probe_Result bench_hashmap_frozen_lookups(
+	struct Hashmap const * hashmap, uint32_t count, uint32_t rounds,
+	uint32_t const * hits, uint32_t const * misses
+) {
+	struct Bench_Probe_Result result = {.valid = true};
+
+	uint64_t const hit_ticks = platform_timer_get_ticks();
+	for (uint32_t round = 0; round < rounds; round++) {
+		for (uint32_t i = 0; i < count; i++) {
+			uint32_t const * value = hashmap_get(hashmap, hits + i);
+			if (value == NULL || *value != i) { result.valid = false; }
+		}
+	}
+	result.hit_ticks = platform_timer_get_ticks() - hit_ticks;
+
+	uint64_t const miss_ticks = platform_timer_get_ticks();
+	for (uint32_t round = 0; round < rounds; round++) {
+		for (uint32_t i = 0; i < count; i++) {
+			if (hashmap_get(hashmap, misses + i) != NULL) { result.valid = false; }
+		}
+	}
+	result.miss_ticks = platform_timer_get_ticks() - miss_ticks;
+
+	return result;
+}
+
+static void bench_hashmap_frozen_keep_best(struct Bench_Probe_Result * best, struct Bench_Probe_Result value) {
+	if (best->hit_ticks  > value.hit_ticks)  { best->hit_ticks  = value.hit_ticks; }
+	if (best->miss_ticks > value.miss_ticks) { best->miss_ticks = value.miss_ticks; }
+	best->valid = best->valid && value.valid;
+}
+
+BENCH(bench_hashmap_frozen) {
+	bool result = true;
+	uint32_t const counts[] = {1 << 10, 1 << 14, 1 << 18, 1 << 20};
+	uint32_t const passes = 5;
+	for (uint32_t count_i = 0; count_i < SIZE_OF_ARRAY(counts); count_i++) {
+		uint32_t const count = counts[count_i];
+		uint32_t const rounds = max_u32((1 << 22) / count, 1);
+		uint32_t const lookups = count * rounds;
+
+		uint32_t * hits   = ALLOCATE_ARRAY(uint32_t, count);
+		uint32_t * misses = ALLOCATE_ARRAY(uint32_t, count);
+		for (uint32_t i = 0; i < count; i++) {
+			hits[i]   = hash_u32_xorshift(i + 1);
+			misses[i] = hash_u32_xorshift(i + 1 + count);
+		}
+
+		// @note: the same keys, probed and frozen
+		struct Hashmap probing = hashmap_init(hash32, sizeof(uint32_t), sizeof(uint32_t));
+		struct Hashmap frozen  = hashmap_init(hash32, sizeof(uint32_t), sizeof(uint32_t));
+		for (uint32_t i = 0; i < count; i++) {
+			hashmap_set(&probing, hits + i, &i);
+			hashmap_set(&frozen,  hits + i, &i);
+		}
+		if (!hashmap_freeze(&frozen)) { result = false; }
+
+		// @note: passes alternate, so that neither way benefits from a warm cache alone
+		struct Bench_Probe_Result best_probing = {UINT64_MAX, UINT64_MAX, true};
+		struct Bench_Probe_Result best_frozen  = {UINT64_MAX, UINT64_MAX, true};
+		for (uint32_t pass = 0; pass < passes && result; pass++) {
+			bench_hashmap_frozen_keep_best(&best_probing, bench_hashmap_frozen_lookups(&probing, count, rounds, hits, misses));
+			bench_hashmap_frozen_keep_best(&best_frozen,  bench_hashmap_frozen_lookups(&frozen,  count, rounds, hits, misses));
+		}
+
+		LOG("%u keys, %u slots:\n", count, probing.capacity);
+		bench_hashmap_probe_log("probing", lookups, best_probing);
+		bench_hashmap_probe_log("frozen",  lookups, best_frozen);
+		result = result && best_probing.valid && best_frozen.valid;
+
+		hashmap_free(&probing);
+		hashmap_free(&frozen);
+		FREE(hits);
+		FREE(misses);
+	}
+	return result;
+}
@@ -0,0 +1,571 @@
+#include "framework/formatter.h"
+#include "framework/maths.h"
+
+#include "framework/platform/allocator.h"
+#include "framework/platform/timer.h"
+#include "framework/platform/file.h"
+#include "framework/platform/memory.h"
+#include "framework/platform/thread.h"
+#include "framework/containers/array.h"
+#include "framework/containers/buffer.h"
+#include "framework/systems/memory.h"
+#include "framework/systems/strings.h"
+
+#include "framework/assets/json.h"
+
+
+//
+#include "bench.h"
+
+// ----- ----- ----- ----- -----
+//     Arena part
+// ----- ----- ----- ----- -----
+
+// @note: a `font_render` frame: an array of symbols to sort, a scratch buffer
+//        that keeps growing while the atlas packs, and a small tail block
+struct Bench_Symbol {
+	uint32_t codepoint;
+	float size;
+	void * glyph;
+};
+
+static void bench_memory_frame(Allocator * allocate, uint32_t symbols_count) {
+	struct Bench_Symbol * symbols = allocate(NULL, sizeof(*symbols) * symbols_count);
+	for (uint32_t i = 0; i < symbols_count; i++) {
+		symbols[i] = (struct Bench_Symbol){.codepoint = i};
+	}
+
+	uint8_t * scratch = NULL;
+	for (uint32_t i = 0, size = 256; i < 8; i++, size *= 2) {
+		scratch = allocate(scratch, size);
+		scratch[size - 1] = (uint8_t)i;
+	}
+	uint32_t * tail = allocate(NULL, sizeof(*tail) * 16);
+	tail[0] = symbols[symbols_count - 1].codepoint + scratch[0];
+
+	allocate(tail, 0);
+	allocate(scratch, 0);
+	allocate(symbols, 0);
+}
+
+static void bench_memory_frame_rewind(uint32_t symbols_count) {
+	struct Memory_Arena_Mark const mark = system_memory_arena_mark();
+	struct Bench_Symbol * symbols = ARENA_ALLOCATE_ARRAY(struct Bench_Symbol, symbols_count);
+	for (uint32_t i = 0; i < symbols_count; i++) {
+		symbols[i] = (struct Bench_Symbol){.codepoint = i};
+	}
+
+	uint8_t * scratch = NULL;
+	for (uint32_t i = 0, size = 256; i < 8; i++, size *= 2) {
+		scratch = realloc_arena(scratch, size);
+		scratch[size - 1] = (uint8_t)i;
+	}
+	uint32_t * tail = ARENA_ALLOCATE_ARRAY(uint32_t, 16);
+	tail[0] = symbols[symbols_count - 1].codepoint + scratch[0];
+
+	system_memory_arena_rewind(mark);
+}
+
+static bool bench_memory_arena_is_at(struct Memory_Arena_Mark mark) {
+	struct Memory_Arena_Mark const current = system_memory_arena_mark();
+	return current.size == mark.size && current.top == mark.top;
+}
+
+static void bench_memory_log(char const * name, uint64_t ticks, uint32_t count) {
+	LOG("  %-10s %8.3f ms total, %8.3f us per run\n", name, platform_timer_get_millis(ticks), platform_timer_get_millis(ticks) * 1000.0 / (double)count);
+}
+
+BENCH(bench_memory_arena) {
+	uint32_t const frames = 100000;
+	uint32_t const symbols_count = 1700;
+
+	bool result = true;
+	struct Memory_Arena_Mark const start = system_memory_arena_mark();
+
+	LOG("font_render frame, %u symbols, %u frames:\n", symbols_count, frames);
+	{
+		uint64_t const ticks = platform_timer_get_ticks();
+		for (uint32_t i = 0; i < frames; i++) { bench_memory_frame(realloc_arena, symbols_count); }
+		bench_memory_log("arena", platform_timer_get_ticks() - ticks, frames);
+		if (!bench_memory_arena_is_at(start)) { result = false; }
+	}
+	{
+		uint64_t const ticks = platform_timer_get_ticks();
+		for (uint32_t i = 0; i < frames; i++) { bench_memory_frame_rewind(symbols_count); }
+		bench_memory_log("rewind", platform_timer_get_ticks() - ticks, frames);
+		if (!bench_memory_arena_is_at(start)) { result = false; }
+	}
+	{
+		uint64_t const ticks = platform_timer_get_ticks();
+		for (uint32_t i = 0; i < frames; i++) { bench_memory_frame(realloc_pool, symbols_count); }
+		bench_memory_log("pool", platform_timer_get_ticks() - ticks, frames);
+	}
+	{
+		uint64_t const ticks = platform_timer_get_ticks();
+		for (uint32_t i = 0; i < frames; i++) { bench_memory_frame(realloc_generic, symbols_count); }
+		bench_memory_log("generic", platform_timer_get_ticks() - ticks, frames);
+	}
+
+	struct CString const path = S_("assets/prototype/test.scene");
+	struct Buffer source = platform_file_read_entire(path);
+	if (source.capacity == 0) {
+		WRN("can't read \"%.*s\", run from the project root", path.length, path.data);
+		return false;
+	}
+
+	uint32_t const parses = 10000;
+	struct CString const text = {.length = (uint32_t)source.size, .data = source.data};
+	struct {
+		char const * name;
+		Allocator * allocate;
+	} const json_allocators[] = {
+		{"arena",   realloc_arena},
+		{"pool",    realloc_pool},
+		{"generic", realloc_generic},
+	};
+
+	system_strings_init();
+	LOG("json_parse + json_free of \"%.*s\", %u bytes, %u runs:\n", path.length, path.data, text.length, parses);
+	for (uint32_t allocator_i = 0; allocator_i < SIZE_OF_ARRAY(json_allocators); allocator_i++) {
+		uint64_t const ticks = platform_timer_get_ticks();
+		for (uint32_t i = 0; i < parses; i++) {
+			struct JSON json = json_parse(text, json_allocators[allocator_i].allocate, NULL);
+			if (json.type != JSON_OBJECT) { result = false; }
+			json_free(&json);
+		}
+		bench_memory_log(json_allocators[allocator_i].name, platform_timer_get_ticks() - ticks, parses);
+	}
+	{
+		uint64_t const ticks = platform_timer_get_ticks();
+		for (uint32_t i = 0; i < parses; i++) {
+			struct Memory_Arena_Mark const mark = system_memory_arena_mark();
+			struct JSON const json = json_parse(text, realloc_arena, NULL);
+			if (json.type != JSON_OBJECT) { result = false; }
+			system_memory_arena_rewind(mark);
+		}
+		bench_memory_log("rewind", platform_timer_get_ticks() - ticks, parses);
+	}
+	if (!bench_memory_arena_is_at(start)) { result = false; }
+	system_strings_free();
+
+	buffer_free(&source);
+	return result;
+}
+
+// ----- ----- ----- ----- -----
+//     Pool part
+// ----- ----- ----- ----- -----
+
+// @note: a trace identifies blocks by the order of their allocation, so it
+//        replays on any allocator; freeing a block is an operation of size `0`
+struct Bench_Trace_Op {
+	uint32_t id;
+	uint32_t size;
+};
+
+static struct Bench_Trace {
+	struct Array ops;      // `struct Bench_Trace_Op`
+	struct Array pointers; // `void *`, per id
+	uint32_t live, peak_live;
+	uint32_t peak_op;      // after which `live` hits its peak
+} gs_bench_trace;
+
+static ALLOCATOR(bench_trace_reallocate) {
+	struct Bench_Trace * trace = &gs_bench_trace;
+
+	uint32_t id = trace->pointers.count;
+	for (uint32_t i = 0; pointer != NULL && i < trace->pointers.count; i++) {
+		if (*(void **)array_at_unsafe(&trace->pointers, i) == pointer) { id = i; break; }
+	}
+	if (id == trace->pointers.count) {
+		if (pointer != NULL) { WRN("unknown trace pointer"); }
+		if (size == 0) { return NULL; }
+		array_push_many(&trace->pointers, 1, &(void *){NULL});
+	}
+
+	void * const result = realloc_generic(pointer, size);
+	*(void **)array_at_unsafe(&trace->pointers, id) = result;
+	array_push_many(&trace->ops, 1, &(struct Bench_Trace_Op){
+		.id = id,
+		.size = (uint32_t)size,
+	});
+
+	if (pointer == NULL && result != NULL) { trace->live++; }
+	if (pointer != NULL && result == NULL) { trace->live--; }
+	if (trace->peak_live < trace->live) {
+		trace->peak_live = trace->live;
+		trace->peak_op = trace->ops.count;
+	}
+	return result;
+}
+
+static void bench_trace_replay(struct Bench_Trace const * trace, Allocator * allocate, void ** pointers, uint32_t from, uint32_t to) {
+	for (uint32_t i = from; i < to; i++) {
+		struct Bench_Trace_Op const * op = array_at_unsafe(&trace->ops, i);
+		pointers[op->id] = allocate(pointers[op->id], op->size);
+		if (op->size > 0) { *(uint8_t *)pointers[op->id] = (uint8_t)i; }
+	}
+}
+
+static bool bench_trace_is_empty(void * const * pointers, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		if (pointers[i] != NULL) { return false; }
+	}
+	return true;
+}
+
+BENCH(bench_memory_pool) {
+	struct CString const paths[] = {
+		S__("assets/prototype/test.scene"),
+		S__("assets/back_buffer.target"),
+		S__("assets/materials/back_buffer.material"),
+		S__("assets/materials/batcher_2d.material"),
+		S__("assets/materials/textured1.material"),
+		S__("assets/materials/textured2.material"),
+		S__("assets/samplers/mipmap.sampler"),
+		S__("assets/test.font"),
+	};
+	uint32_t const paths_count = (uint32_t)SIZE_OF_ARRAY(paths);
+
+	// @note: record the scene and the JSON assets it references, all of them
+	//        staying alive until the scene is loaded, as `json_load` has it
+	gs_bench_trace = (struct Bench_Trace){
+		.ops = array_init(sizeof(struct Bench_Trace_Op)),
+		.pointers = array_init(sizeof(void *)),
+	};
+	struct JSON jsons[SIZE_OF_ARRAY(paths)];
+	bool result = true;
+
+	system_strings_init();
+	for (uint32_t i = 0; i < paths_count; i++) {
+		struct Buffer source = platform_file_read_entire(paths[i]);
+		if (source.capacity == 0) {
+			WRN("can't read \"%.*s\", run from the project root", paths[i].length, paths[i].data);
+			result = false;
+		}
+		struct CString const text = {.length = (uint32_t)source.size, .data = source.data};
+		jsons[i] = json_parse(text, bench_trace_reallocate, NULL);
+		buffer_free(&source);
+	}
+	for (uint32_t i = 0; i < paths_count; i++) {
+		json_free(jsons + i);
+	}
+	system_strings_free();
+
+	struct Bench_Trace const * trace = &gs_bench_trace;
+	uint32_t const ids_count = trace->pointers.count;
+	if (trace->live != 0) { result = false; }
+	LOG("trace of %u JSON files: %u ops, %u blocks, %u live at the peak\n", paths_count, trace->ops.count, ids_count, trace->peak_live);
+
+	// @note: the pool state at the peak of the trace
+	void ** pointers = ALLOCATE_ARRAY(void *, ids_count);
+	common_memset(pointers, 0, sizeof(*pointers) * ids_count);
+	{
+		struct Memory_Pool_Stats const before = system_memory_pool_get_stats();
+		bench_trace_replay(trace, realloc_pool, pointers, 0, trace->peak_op);
+		struct Memory_Pool_Stats const peak = system_memory_pool_get_stats();
+		bench_trace_replay(trace, realloc_pool, pointers, trace->peak_op, trace->ops.count);
+		struct Memory_Pool_Stats const after = system_memory_pool_get_stats();
+		if (!bench_trace_is_empty(pointers, ids_count)) { result = false; }
+
+		LOG("  %-6s %6s %6s %8s %8s %10s\n", "class", "slabs", "blocks", "used", "internal", "external");
+		for (uint32_t i = 0; i < SYSTEM_MEMORY_POOL_CLASSES; i++) {
+			struct Memory_Pool_Class_Stats const * stats = peak.classes + i;
+			uint32_t const count = stats->count - before.classes[i].count;
+			size_t const bytes = stats->bytes - before.classes[i].bytes;
+			if (after.classes[i].count != before.classes[i].count) { result = false; }
+			if (count == 0) { continue; }
+
+			// @note: internal is waste within used blocks, external is unused blocks of the slabs
+			double const internal = 1 - (double)bytes / (double)(count * stats->block_size);
+			double const external = 1 - (double)stats->count / (double)stats->capacity;
+			LOG("  %-6u %6u %6u %8u %7.1f%% %9.1f%%\n", stats->block_size, stats->slabs, stats->capacity, count, internal * 100, external * 100);
+		}
+		uint32_t const large_count = peak.large_count - before.large_count;
+		LOG("  %-6s %6s %6s %8u\n", "large", "", "", large_count);
+	}
+
+	uint32_t const replays = 2000;
+	struct {
+		char const * name;
+		Allocator * allocate;
+	} const allocators[] = {
+		{"pool",     realloc_pool},
+		{"generic",  realloc_generic},
+		{"platform", platform_reallocate},
+	};
+	LOG("replayed %u times:\n", replays);
+	for (uint32_t allocator_i = 0; allocator_i < SIZE_OF_ARRAY(allocators); allocator_i++) {
+		uint64_t const ticks = platform_timer_get_ticks();
+		for (uint32_t i = 0; i < replays; i++) {
+			bench_trace_replay(trace, allocators[allocator_i].allocate, pointers, 0, trace->ops.count);
+		}
+		uint64_t const elapsed = platform_timer_get_ticks() - ticks;
+		if (!bench_trace_is_empty(pointers, ids_count)) { result = false; }
+
+		double const ops = (double)trace->ops.count * replays;
+		LOG("  %-10s %8.3f ms total, %6.2f ns per op\n", allocators[allocator_i].name, platform_timer_get_millis(elapsed), platform_timer_get_millis(elapsed) * 1000000.0 / ops);
+	}
+
+	FREE(pointers);
+	array_free(&gs_bench_trace.ops);
+	array_free(&gs_bench_trace.pointers);
+	return result;
+}
+
+// ----- ----- ----- ----- -----
+//     Threads part
+// ----- ----- ----- ----- -----
+
+#define BENCH_MEMORY_THREADS 8
+#define BENCH_MEMORY_SLOTS 64
+
+struct Bench_Memory_Slot {
+	uint8_t * data;
+	uint32_t size;
+	uint8_t stamp;
+};
+
+struct Bench_Memory_Thread {
+	uint32_t index, ops;
+	uint32_t failures;
+	uint8_t * leaked; // a debug block, freed by the main thread
+	uint32_t leaked_size;
+};
+
+static bool bench_memory_slot_is_valid(struct Bench_Memory_Slot const * slot, uint32_t size) {
+	for (uint32_t i = 0; i < size; i++) {
+		if (slot->data[i] != slot->stamp) { return false; }
+	}
+	return true;
+}
+
+static THREAD_PROC(bench_memory_thread) {
+	struct Bench_Memory_Thread * thread = data;
+	Allocator * const allocators[] = {realloc_pool, realloc_debug, realloc_generic};
+	uint32_t const allocators_count = (uint32_t)SIZE_OF_ARRAY(allocators);
+
+	struct Bench_Memory_Slot slots[SIZE_OF_ARRAY(allocators)][BENCH_MEMORY_SLOTS];
+	common_memset(slots, 0, sizeof(slots));
+
+	uint32_t random = hash_u32_xorshift(thread->index + 1);
+	for (uint32_t op = 0; op < thread->ops; op++) {
+		random = hash_u32_xorshift(random);
+		uint32_t const allocator_i = random % allocators_count;
+		struct Bench_Memory_Slot * slot = slots[allocator_i] + (random >> 8) % BENCH_MEMORY_SLOTS;
+		Allocator * allocate = allocators[allocator_i];
+
+		uint32_t const size = 1 + (random >> 16) % 4096;
+		uint8_t const stamp = (uint8_t)(op ^ thread->index);
+		if (slot->data == NULL) {
+			slot->data = allocate(NULL, size);
+		}
+		else if (random & (1 << 7)) {
+			if (!bench_memory_slot_is_valid(slot, min_u32(slot->size, size))) { thread->failures++; }
+			slot->data = allocate(slot->data, size);
+		}
+		else {
+			if (!bench_memory_slot_is_valid(slot, slot->size)) { thread->failures++; }
+			allocate(slot->data, 0);
+			slot->data = NULL;
+			continue;
+		}
+		slot->size = size;
+		slot->stamp = stamp;
+		common_memset(slot->data, stamp, size);
+
+		// @note: a scope of its own on the arena of this thread
+		if (op % 64 == 0) {
+			struct Memory_Arena_Mark const mark = system_memory_arena_mark();
+			uint8_t * block = ARENA_ALLOCATE_ARRAY(uint8_t, 256);
+			common_memset(block, stamp, 256);
+			uint8_t const inverse = (uint8_t)~stamp;
+			uint8_t * other = ARENA_ALLOCATE_ARRAY(uint8_t, 64);
+			common_memset(other, inverse, 64);
+			other = realloc_arena(other, 16 * 1024);
+			if (block[255] != stamp || other[63] != inverse) { thread->failures++; }
+			system_memory_arena_rewind(mark);
+		}
+	}
+
+	for (uint32_t allocator_i = 0; allocator_i < allocators_count; allocator_i++) {
+		for (uint32_t i = 0; i < BENCH_MEMORY_SLOTS; i++) {
+			struct Bench_Memory_Slot * slot = slots[allocator_i] + i;
+			if (slot->data == NULL) { continue; }
+			if (!bench_memory_slot_is_valid(slot, slot->size)) { thread->failures++; }
+			allocators[allocator_i](slot->data, 0);
+		}
+	}
+
+	thread->leaked_size = 1 + thread->index;
+	thread->leaked = realloc_debug(NULL, thread->leaked_size);
+	system_memory_arena_detach();
+}
+
+BENCH(bench_memory_threads) {
+	uint32_t const ops = 20000;
+	enum Memory_Type const types[] = {MEMORY_TYPE_POOL, MEMORY_TYPE_DEBUG, MEMORY_TYPE_GENERIC};
+	uint64_t lives[SIZE_OF_ARRAY(types)];
+	for (uint32_t i = 0; i < SIZE_OF_ARRAY(types); i++) {
+		lives[i] = system_memory_get_telemetry(types[i]).live;
+	}
+
+	struct Bench_Memory_Thread threads[BENCH_MEMORY_THREADS];
+	void * handles[BENCH_MEMORY_THREADS];
+	uint64_t const ticks = platform_timer_get_ticks();
+	for (uint32_t i = 0; i < BENCH_MEMORY_THREADS; i++) {
+		threads[i] = (struct Bench_Memory_Thread){.index = i, .ops = ops};
+		handles[i] = platform_thread_start(bench_memory_thread, threads + i);
+	}
+	for (uint32_t i = 0; i < BENCH_MEMORY_THREADS; i++) {
+		platform_thread_join(handles[i]);
+	}
+	uint64_t const elapsed = platform_timer_get_ticks() - ticks;
+
+	bool result = true;
+	uint64_t leaked = 0;
+	for (uint32_t i = 0; i < BENCH_MEMORY_THREADS; i++) {
+		if (threads[i].failures > 0) { result = false; }
+		leaked += threads[i].leaked_size;
+	}
+
+	// @note: the leak report sees blocks of every thread, until any thread frees them
+	uint64_t const debug_live = system_memory_get_telemetry(MEMORY_TYPE_DEBUG).live;
+	if (debug_live != lives[1] + leaked) { result = false; }
+	for (uint32_t i = 0; i < BENCH_MEMORY_THREADS; i++) {
+		realloc_debug(threads[i].leaked, 0);
+	}
+	for (uint32_t i = 0; i < SIZE_OF_ARRAY(types); i++) {
+		if (system_memory_get_telemetry(types[i]).live != lives[i]) { result = false; }
+	}
+
+	double const total_ops = (double)ops * BENCH_MEMORY_THREADS;
+	LOG("%u threads, %u ops each on pool, debug and generic, plus arena scopes: %s\n", BENCH_MEMORY_THREADS, ops, result ? "valid" : "INVALID");
+	LOG("  %-10s %8.3f ms total, %6.2f ns per op\n", "threads", platform_timer_get_millis(elapsed), platform_timer_get_millis(elapsed) * 1000000.0 / total_ops);
+	LOG("  %-10s %8llu bytes in %u blocks, freed by the main thread\n", "leaked", (unsigned long long)leaked, BENCH_MEMORY_THREADS);
+	return result;
+}
+
+#undef BENCH_MEMORY_THREADS
+#undef BENCH_MEMORY_SLOTS
+
+// ----- ----- ----- ----- -----
+//     Virtual memory part
+// ----- ----- ----- ----- -----
+
+// @note: an arena commits pages by 64KiB steps, see `SYSTEM_MEMORY_ARENA_COMMIT_STEP`
+#define BENCH_MEMORY_COMMIT_STEP (64 * (1 << 10))
+#define BENCH_MEMORY_GROWTH 256
+
+static uint8_t bench_memory_get_pattern(size_t index) {
+	return (uint8_t)((index * 31) ^ (index >> 12));
+}
+
+static bool bench_memory_virtual_commit(size_t size) {
+	size_t const page_size = platform_memory_get_page_size();
+	size_t const step = (BENCH_MEMORY_COMMIT_STEP + page_size - 1) / page_size * page_size;
+	size_t const reserved = (size + step - 1) / step * step;
+
+	uint8_t * data = platform_memory_reserve(reserved);
+	if (data == NULL) { return false; }
+
+	// @note: commit step by step, as an arena does, touching every page
+	bool result = true;
+	for (size_t committed = 0; committed < reserved && result; committed += step) {
+		result = platform_memory_commit(data + committed, step);
+		for (size_t i = committed; i < committed + step && result; i += page_size) {
+			data[i] = bench_memory_get_pattern(i);
+		}
+	}
+	for (size_t i = 0; i < reserved && result; i += page_size) {
+		if (data[i] != bench_memory_get_pattern(i)) { result = false; }
+	}
+
+	// @note: decommitted pages come back zeroed
+	if (result) {
+		platform_memory_decommit(data, reserved / 2);
+		result = platform_memory_commit(data, reserved / 2);
+		for (size_t i = 0; i < reserved / 2 && result; i += page_size) {
+			if (data[i] != 0) { result = false; }
+		}
+	}
+
+	platform_memory_release(data, reserved);
+	return result;
+}
+
+static bool bench_memory_arena_blocks(size_t size) {
+	// @note: a stream of small blocks of varying sizes, then freed in reverse
+	struct Memory_Arena_Mark const start = system_memory_arena_mark();
+	struct Array blocks = array_init(sizeof(uint8_t *));
+	bool result = true;
+
+	size_t total = 0;
+	for (uint32_t i = 0; total < size; i++) {
+		size_t const block_size = 16 + (hash_u32_xorshift(i + 1) % 4096);
+		uint8_t * block = realloc_arena(NULL, block_size);
+		if (block == NULL) { result = false; break; }
+		common_memset(block, (uint8_t)i, block_size);
+		array_push_many(&blocks, 1, &block);
+		total += block_size;
+	}
+
+	for (uint32_t i = blocks.count; i > 0; i--) {
+		uint8_t * block = *(uint8_t **)array_at(&blocks, i - 1);
+		if (block[0] != (uint8_t)(i - 1)) { result = false; }
+		ARENA_FREE(block);
+	}
+	array_free(&blocks);
+
+	struct Memory_Arena_Mark const end = system_memory_arena_mark();
+	return result && end.size == start.size && end.top == start.top;
+}
+
+static bool bench_memory_arena_grow(size_t size) {
+	// @note: the top block grows in place, with no copies
+	uint8_t * const block = realloc_arena(NULL, 64);
+	if (block == NULL) { return false; }
+	block[0] = 0x5a;
+
+	bool result = true;
+	size_t filled = 64;
+	for (size_t block_size = 128; block_size <= size && result; block_size *= 2) {
+		if (realloc_arena(block, block_size) != block) { result = false; break; }
+		for (size_t i = filled; i < block_size; i++) { block[i] = bench_memory_get_pattern(i); }
+		filled = block_size;
+	}
+
+	if (block[0] != 0x5a) { result = false; }
+	for (size_t i = 64; i < filled && result; i++) {
+		if (block[i] != bench_memory_get_pattern(i)) { result = false; }
+	}
+
+	ARENA_FREE(block);
+	return result;
+}
+
+BENCH(bench_memory_virtual) {
+	size_t const size = (size_t)BENCH_MEMORY_COMMIT_STEP * BENCH_MEMORY_GROWTH;
+	LOG("growth up to %u times the initial commit, %.1f MiB:\n", BENCH_MEMORY_GROWTH, (double)size / (1 << 20));
+
+	bool result = true;
+	struct {
+		char const * name;
+		bool (* run)(size_t size);
+	} const cases[] = {
+		{"commit", bench_memory_virtual_commit},
+		{"blocks", bench_memory_arena_blocks},
+		{"grow",   bench_memory_arena_grow},
+	};
+	for (uint32_t i = 0; i < SIZE_OF_ARRAY(cases); i++) {
+		uint64_t const ticks = platform_timer_get_ticks();
+		bool const valid = cases[i].run(size);
+		LOG("  %-10s %8.3f ms, %s\n", cases[i].name, platform_timer_get_millis(platform_timer_get_ticks() - ticks), valid ? "valid" : "INVALID");
+		result = result && valid;
+	}
+
+	return result;
+}
+
+#undef BENCH_MEMORY_COMMIT_STEP
+#undef BENCH_MEMORY_GROWTH
@@ -0,0 +1,303 @@
+#include "framework/formatter.h"
+#include "framework/json_read.h"
+
+#include "framework/platform/timer.h"
+#include "framework/platform/thread.h"
+#include "framework/containers/array.h"
+#include "framework/containers/buffer.h"
+
+#include "framework/systems/memory.h"
+#include "framework/systems/strings.h"
+#include "framework/systems/jobs.h"
+#include "framework/systems/packs.h"
+#include "framework/systems/assets.h"
+
+#include "framework/assets/json.h"
+#include "framework/assets/image.h"
+#include "framework/assets/mesh.h"
+#include "framework/assets/typeface.h"
+
+#include "application/json_preload.h"
+
+
+//
+#include "bench.h"
+
+// @note: headless stand-ins for `asset_types.c`, of the same names and extensions;
+//        leaves read and decode their files in `prepare`, as the real ones do,
+//        and skip the GPU upload in `load`; descriptors walk their JSON in `load`,
+//        loading what they refer to synchronously, as materials and fonts do;
+//        the latter become dependencies, which the system drops on its own
+
+struct Bench_Scene_Asset {
+	uint32_t bytes;
+};
+
+static uint32_t * bench_scene_stage(uint64_t bytes) {
+	uint32_t * result = ALLOCATE(uint32_t);
+	*result = (uint32_t)bytes;
+	return result;
+}
+
+static ASSET_PREPARE(bench_scene_file_prepare) {
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+	uint64_t const bytes = file_buffer.size;
+	buffer_free(&file_buffer);
+	return bench_scene_stage(bytes);
+}
+
+static ASSET_PREPARE(bench_scene_image_prepare) {
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+	struct Image image = image_init(&file_buffer);
+	buffer_free(&file_buffer);
+	uint64_t const bytes = (uint64_t)image.size.x * image.size.y * gfx_type_get_size(image.format.type);
+	image_free(&image);
+	return bench_scene_stage(bytes);
+}
+
+static ASSET_PREPARE(bench_scene_typeface_prepare) {
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+	uint64_t const bytes = file_buffer.size;
+	struct Typeface * typeface = typeface_init(&file_buffer);
+	typeface_free(typeface);
+	return bench_scene_stage(bytes);
+}
+
+static ASSET_PREPARE(bench_scene_model_prepare) {
+	struct Buffer file_buffer = system_packs_read(name);
+	if (file_buffer.capacity == 0) { return NULL; }
+	struct Mesh mesh = mesh_init(&file_buffer);
+	buffer_free(&file_buffer);
+	uint64_t bytes = 0;
+	FOR_ARRAY(&mesh.buffers, it) {
+		struct Mesh_Buffer const * mesh_buffer = it.value;
+		bytes += mesh_buffer->buffer.size;
+	}
+	mesh_free(&mesh);
+	return bench_scene_stage(bytes);
+}
+
+static HANDLE_ACTION(bench_scene_leaf_load) {
+	struct Bench_Scene_Asset * asset = system_assets_get(handle);
+	uint32_t * staged = system_assets_get_staged(handle);
+	*asset = (struct Bench_Scene_Asset){
+		.bytes = (staged != NULL) ? *staged : 0,
+	};
+	FREE(staged);
+}
+
+static HANDLE_ACTION(bench_scene_asset_drop) {
+	struct Bench_Scene_Asset * asset = system_assets_get(handle);
+	cbuffer_clear(CBMP_(asset));
+}
+
+static JSON_PROCESSOR(bench_scene_load_value) {
+	struct Array * handles = data;
+
+	switch (json->type) {
+		default: break;
+
+		case JSON_OBJECT: {
+			FOR_DICTIONARY(&json->as.table, it) {
+				bench_scene_load_value(it.value, handles);
+			}
+		} break;
+
+		case JSON_ARRAY: {
+			FOR_ARRAY(&json->as.array, it) {
+				bench_scene_load_value(it.value, handles);
+			}
+		} break;
+
+		case JSON_STRING: {
+			struct CString const path = system_strings_get(json->as.sh_string);
+			if (system_assets_get_info(path) == NULL) { return; }
+			struct Handle const ah_asset = system_assets_load(path);
+			array_push_many(handles, 1, &ah_asset);
+		} break;
+	}
+}
+
+static HANDLE_ACTION(bench_scene_descriptor_load) {
+	struct Array handles = array_init(sizeof(struct Handle));
+	process_json(system_assets_get_name(handle), &handles, bench_scene_load_value);
+
+	struct Bench_Scene_Asset * asset = system_assets_get(handle);
+	*asset = (struct Bench_Scene_Asset){
+		.bytes = handles.count,
+	};
+	array_free(&handles);
+}
+
+static void bench_scene_types_set(void) {
+	system_assets_type_map(S_("bytes"),    S_("txt"));
+	system_assets_type_map(S_("shader"),   S_("glsl"));
+	system_assets_type_map(S_("image"),    S_("png"));
+	system_assets_type_map(S_("typeface"), S_("ttf"));
+	system_assets_type_map(S_("typeface"), S_("otf"));
+	system_assets_type_map(S_("model"),    S_("obj"));
+
+	struct {
+		struct CString name;
+		Asset_Prepare * prepare;
+	} const leaves[] = {
+		{S__("bytes"),    bench_scene_file_prepare},
+		{S__("shader"),   bench_scene_file_prepare},
+		{S__("image"),    bench_scene_image_prepare},
+		{S__("typeface"), bench_scene_typeface_prepare},
+		{S__("model"),    bench_scene_model_prepare},
+	};
+	for (uint32_t i = 0; i < SIZE_OF_ARRAY(leaves); i++) {
+		system_assets_type_set(leaves[i].name, (struct Asset_Info){
+			.size = sizeof(struct Bench_Scene_Asset),
+			.prepare = leaves[i].prepare,
+			.load = bench_scene_leaf_load,
+			.drop = bench_scene_asset_drop,
+		});
+	}
+
+	struct CString const descriptors[] = {
+		S__("sampler"),
+		S__("target"),
+		S__("font"),
+		S__("material"),
+	};
+	for (uint32_t i = 0; i < SIZE_OF_ARRAY(descriptors); i++) {
+		system_assets_type_set(descriptors[i], (struct Asset_Info){
+			.size = sizeof(struct Bench_Scene_Asset),
+			.load = bench_scene_descriptor_load,
+			.drop = bench_scene_asset_drop,
+		});
+	}
+}
+
+static void bench_scene_types_del(void) {
+	struct CString const types[] = {
+		S__("bytes"), S__("shader"), S__("image"), S__("typeface"), S__("model"),
+		S__("sampler"), S__("target"), S__("font"), S__("material"),
+	};
+	for (uint32_t i = 0; i < SIZE_OF_ARRAY(types); i++) {
+		system_assets_type_del(types[i]);
+	}
+}
+
+//
+
+static void bench_scene_push(struct Buffer * buffer, struct CString value) {
+	buffer_push_many(buffer, value.length, value.data);
+}
+
+// @note: every entity keeps the asset references of a `source` one, in turn
+static void bench_scene_generate(struct JSON const * source, uint32_t count, struct Buffer * buffer) {
+	struct JSON const * entities = json_get(source, S_("entities"));
+	uint32_t const entities_count = json_count(entities);
+
+	bench_scene_push(buffer, S_("{\"entities\": ["));
+	for (uint32_t i = 0; i < count && entities_count > 0; i++) {
+		struct JSON const * entity = json_at(entities, i % entities_count);
+		bench_scene_push(buffer, S_("{"));
+		FOR_DICTIONARY(&entity->as.table, it) {
+			struct JSON const * value = it.value;
+			if (value->type != JSON_STRING) { continue; }
+
+			struct CString const path = json_as_string(value);
+			if (system_assets_get_info(path) == NULL) { continue; }
+
+			struct CString const key = system_strings_get(*(struct Handle const *)it.key);
+			bench_scene_push(buffer, S_("\""));
+			bench_scene_push(buffer, key);
+			bench_scene_push(buffer, S_("\": \""));
+			bench_scene_push(buffer, path);
+			bench_scene_push(buffer, S_("\", "));
+		}
+		bench_scene_push(buffer, S_("}, "));
+	}
+	bench_scene_push(buffer, S_("]}"));
+}
+
+static uint64_t bench_scene_load(struct JSON const * scene, bool preload, uint32_t * loaded) {
+	struct Array handles = array_init(sizeof(struct Handle));
+	struct Array preloaded = array_init(sizeof(struct Handle));
+
+	uint64_t const ticks = platform_timer_get_ticks();
+	if (preload) { json_load_preload(scene, &preloaded); }
+	bench_scene_load_value(scene, &handles);
+	uint64_t const elapsed = platform_timer_get_ticks() - ticks;
+
+	*loaded = 0;
+	FOR_ARRAY(&handles, it) {
+		struct Handle const * ah_asset = it.value;
+		if (system_assets_get(*ah_asset) != NULL) { (*loaded)++; }
+	}
+
+	// @note: types keep nothing, thus the next load starts from scratch
+	FOR_ARRAY(&preloaded, it) {
+		struct Handle const * ah_asset = it.value;
+		system_assets_drop(*ah_asset);
+	}
+	FOR_ARRAY(&handles, it) {
+		struct Handle const * ah_asset = it.value;
+		system_assets_drop(*ah_asset);
+	}
+	array_free(&preloaded);
+	array_free(&handles);
+	return elapsed;
+}
+
+BENCH(bench_scene_preload) {
+	uint32_t const entities = 1000;
+	uint32_t const rounds = 16;
+
+	system_strings_init();
+	system_assets_init();
+	system_jobs_init(0);
+	system_packs_init();
+	bench_scene_types_set();
+
+	struct Buffer source_buffer = system_packs_read(S_("assets/prototype/test.scene"));
+	struct JSON source = json_parse((struct CString){
+		.length = (uint32_t)source_buffer.size,
+		.data = source_buffer.data,
+	}, NULL, NULL);
+	buffer_free(&source_buffer);
+
+	struct Buffer scene_buffer = buffer_init();
+	if (source.type == JSON_OBJECT) { bench_scene_generate(&source, entities, &scene_buffer); }
+	json_free(&source);
+
+	struct JSON scene = json_parse((struct CString){
+		.length = (uint32_t)scene_buffer.size,
+		.data = scene_buffer.data,
+	}, NULL, NULL);
+	buffer_free(&scene_buffer);
+
+	bool result = json_count(json_get(&scene, S_("entities"))) == entities;
+	if (!result) { WRN("can't generate the scene, run from the project root"); }
+
+	// @note: rounds alternate, so that both see the same state of the OS file cache
+	uint32_t loaded_serial = 0, loaded_preload = 0;
+	uint64_t best_serial = UINT64_MAX, best_preload = UINT64_MAX;
+	bench_scene_load(&scene, false, &loaded_serial);
+	for (uint32_t round = 0; round < rounds && result; round++) {
+		uint64_t const serial  = bench_scene_load(&scene, false, &loaded_serial);
+		uint64_t const preload = bench_scene_load(&scene, true,  &loaded_preload);
+		if (best_serial  > serial)  { best_serial  = serial; }
+		if (best_preload > preload) { best_preload = preload; }
+		if (loaded_serial != loaded_preload) { result = false; }
+	}
+
+	LOG("%u entities, %u asset references, cores %u, best of %u rounds: %s\n", entities, loaded_serial, platform_thread_get_cores(), rounds, result ? "valid" : "INVALID");
+	LOG("  %-10s %8.3f ms\n", "serial",  platform_timer_get_millis(best_serial));
+	LOG("  %-10s %8.3f ms\n", "preload", platform_timer_get_millis(best_preload));
+
+	json_free(&scene);
+	bench_scene_types_del();
+	system_assets_free();
+	system_packs_free();
+	system_jobs_free();
+	system_strings_free();
+	return result;
+}
@@ -0,0 +1,73 @@
+#include "framework/formatter.h"
+#include "framework/maths.h"
+
+#include "framework/platform/timer.h"
+#include "framework/systems/memory.h"
+#include "framework/systems/strings.h"
+
+
+//
+#include "bench.h"
+
+// @note: names the way assets and JSON keys look, of a fixed stride
+#define BENCH_STRINGS_STRIDE 32
+
+static struct CString bench_strings_name(char * buffer, char const * prefix, uint32_t index) {
+	uint32_t const length = formatter_fmt(BENCH_STRINGS_STRIDE, buffer, "%s/%08x.asset", prefix, hash_u32_xorshift(index + 1));
+	return (struct CString){.length = length, .data = buffer};
+}
+
+BENCH(bench_strings_lookup) {
+	bool result = true;
+	uint32_t const counts[] = {1 << 8, 1 << 12, 1 << 16, 1 << 18};
+	for (uint32_t count_i = 0; count_i < SIZE_OF_ARRAY(counts); count_i++) {
+		uint32_t const count = counts[count_i];
+		uint32_t const rounds = max_u32((1 << 22) / count, 1);
+		uint32_t const lookups = count * rounds;
+
+		char * hits_data   = ALLOCATE_ARRAY(char, (size_t)count * BENCH_STRINGS_STRIDE);
+		char * misses_data = ALLOCATE_ARRAY(char, (size_t)count * BENCH_STRINGS_STRIDE);
+		struct CString * hits   = ALLOCATE_ARRAY(struct CString, count);
+		struct CString * misses = ALLOCATE_ARRAY(struct CString, count);
+		uint32_t * ids = ALLOCATE_ARRAY(uint32_t, count);
+
+		system_strings_init();
+		for (uint32_t i = 0; i < count; i++) {
+			hits[i]   = bench_strings_name(hits_data   + (size_t)i * BENCH_STRINGS_STRIDE, "hit",  i);
+			misses[i] = bench_strings_name(misses_data + (size_t)i * BENCH_STRINGS_STRIDE, "miss", i);
+			ids[i] = system_strings_add(hits[i]).id;
+		}
+
+		uint64_t const hit_ticks = platform_timer_get_ticks();
+		for (uint32_t round = 0; round < rounds; round++) {
+			for (uint32_t i = 0; i < count; i++) {
+				if (system_strings_find(hits[i]).id != ids[i]) { result = false; }
+			}
+		}
+		uint64_t const hit_elapsed = platform_timer_get_ticks() - hit_ticks;
+
+		uint64_t const miss_ticks = platform_timer_get_ticks();
+		for (uint32_t round = 0; round < rounds; round++) {
+			for (uint32_t i = 0; i < count; i++) {
+				if (system_strings_find(misses[i]).id != 0) { result = false; }
+			}
+		}
+		uint64_t const miss_elapsed = platform_timer_get_ticks() - miss_ticks;
+		system_strings_free();
+
+		LOG("%u strings: hit %6.2f ns, miss %6.2f ns\n"
+			, count
+			, platform_timer_get_millis(hit_elapsed)  * 1000000.0 / (double)lookups
+			, platform_timer_get_millis(miss_elapsed) * 1000000.0 / (double)lookups
+		);
+
+		FREE(hits_data);
+		FREE(misses_data);
+		FREE(hits);
+		FREE(misses);
+		FREE(ids);
+	}
+	return result;
+}
+
+#undef BENCH_STRINGS_STRIDE
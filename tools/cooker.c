@@ -0,0 +1,206 @@
+#include "framework/formatter.h"
+#include "framework/maths.h"
+
+#include "framework/platform/file.h"
+#include "framework/platform/timer.h"
+#include "framework/containers/array.h"
+#include "framework/containers/buffer.h"
+
+#include "framework/systems/memory.h"
+
+#include "framework/assets/cooked.h"
+#include "framework/assets/image.h"
+#include "framework/assets/mesh.h"
+
+#include "tools/arguments.h"
+
+// @note: usage
+//        `cooker <directory>...`        cooks every `.png` and `.obj` found,
+//                                       skipping blobs of the same version and source hash
+//        `cooker -bench <directory>...` times decoding the sources
+//                                       against initializing from the blobs
+
+struct Cooker_Source {
+	struct CString path;
+	enum Cooked_Type type;
+};
+
+static FILE_VISITOR(cooker_collect) {
+	enum Cooked_Type type = COOKED_TYPE_NONE;
+	if      (cstring_ends(path, S_(".png"))) { type = COOKED_TYPE_IMAGE; }
+	else if (cstring_ends(path, S_(".obj"))) { type = COOKED_TYPE_MESH; }
+	if (type == COOKED_TYPE_NONE) { return; }
+
+	struct Array * sources = data;
+	char * path_data = ALLOCATE_ARRAY(char, path.length + 1);
+	common_memcpy(path_data, path.data, path.length);
+	path_data[path.length] = '\0';
+	array_push_many(sources, 1, &(struct Cooker_Source){
+		.path = {
+			.length = path.length,
+			.data = path_data,
+		},
+		.type = type,
+	});
+}
+
+// @note: allocated on the arena
+static struct CString cooker_get_cooked_path(struct CString path) {
+	struct CString const cooked_suffix = S_(COOKED_SUFFIX);
+	char * cooked_path_data = ARENA_ALLOCATE_ARRAY(char, path.length + cooked_suffix.length + 1);
+	common_memcpy(cooked_path_data, path.data, path.length);
+	common_memcpy(cooked_path_data + path.length, cooked_suffix.data, cooked_suffix.length);
+	cooked_path_data[path.length + cooked_suffix.length] = '\0';
+	return (struct CString){
+		.length = path.length + cooked_suffix.length,
+		.data = cooked_path_data,
+	};
+}
+
+static struct Buffer cooker_read_cooked(struct CString path) {
+	struct CString const cooked_path = cooker_get_cooked_path(path);
+	struct Buffer const result = platform_file_read_entire(cooked_path);
+	ARENA_FREE((char *)(size_t)cooked_path.data);
+	return result;
+}
+
+static bool cooker_write_cooked(struct CString path, struct Buffer const * blob) {
+	struct CString const cooked_path = cooker_get_cooked_path(path);
+	struct File * file = platform_file_init(cooked_path, FILE_MODE_WRITE | FILE_MODE_FORCE);
+	ARENA_FREE((char *)(size_t)cooked_path.data);
+	if (file == NULL) { return false; }
+
+	uint64_t const written = platform_file_write(file, blob->data, blob->size);
+	platform_file_end(file);
+	platform_file_free(file);
+	return written == blob->size;
+}
+
+static bool cooker_cook(struct Cooker_Source const * source, bool * fresh) {
+	struct Buffer source_buffer = platform_file_read_entire(source->path);
+	if (source_buffer.size == 0) { buffer_free(&source_buffer); return false; }
+	uint64_t const source_hash = hash_u64_fnv1(source_buffer.data, source_buffer.size);
+
+	struct Buffer cooked_buffer = cooker_read_cooked(source->path);
+	struct CBuffer const existing = {
+		.size = cooked_buffer.size,
+		.data = cooked_buffer.data,
+	};
+	*fresh = cooked_get_payload(existing, source->type).size > 0
+	      && cooked_get_source_hash(existing) == source_hash;
+	buffer_free(&cooked_buffer);
+	if (*fresh) { buffer_free(&source_buffer); return true; }
+
+	struct Buffer blob = buffer_init();
+	cooked_init(&blob, source->type, source_hash);
+	switch (source->type) {
+		case COOKED_TYPE_NONE: break;
+
+		case COOKED_TYPE_IMAGE: {
+			struct Image image = image_init(&source_buffer);
+			image_cook(&image, &blob);
+			image_free(&image);
+		} break;
+
+		case COOKED_TYPE_MESH: {
+			struct Mesh mesh = mesh_init(&source_buffer);
+			mesh_cook(&mesh, &blob);
+			mesh_free(&mesh);
+		} break;
+	}
+	buffer_free(&source_buffer);
+
+	bool const result = cooker_write_cooked(source->path, &blob);
+	buffer_free(&blob);
+	return result;
+}
+
+static void cooker_bench(struct Array const * sources) {
+	uint64_t source_size = 0;
+	uint64_t const source_ticks = platform_timer_get_ticks();
+	FOR_ARRAY(sources, it) {
+		struct Cooker_Source const * source = it.value;
+		struct Buffer file_buffer = platform_file_read_entire(source->path);
+		source_size += file_buffer.size;
+		switch (source->type) {
+			case COOKED_TYPE_NONE: break;
+			case COOKED_TYPE_IMAGE: { struct Image image = image_init(&file_buffer); image_free(&image); } break;
+			case COOKED_TYPE_MESH:  { struct Mesh  mesh  = mesh_init(&file_buffer);  mesh_free(&mesh);   } break;
+		}
+		buffer_free(&file_buffer);
+	}
+	uint64_t const source_elapsed = platform_timer_get_ticks() - source_ticks;
+
+	uint32_t stale_count = 0;
+	uint64_t cooked_size = 0;
+	uint64_t const cooked_ticks = platform_timer_get_ticks();
+	FOR_ARRAY(sources, it) {
+		struct Cooker_Source const * source = it.value;
+		struct Buffer file_buffer = cooker_read_cooked(source->path);
+		cooked_size += file_buffer.size;
+		struct CBuffer const payload = cooked_get_payload((struct CBuffer){
+			.size = file_buffer.size,
+			.data = file_buffer.data,
+		}, source->type);
+		if (payload.size == 0) { stale_count++; }
+		else switch (source->type) {
+			case COOKED_TYPE_NONE: break;
+			case COOKED_TYPE_IMAGE: { struct Image image = image_init_cooked(payload); image_free(&image); } break;
+			case COOKED_TYPE_MESH:  { struct Mesh  mesh  = mesh_init_cooked(payload);  mesh_free(&mesh);   } break;
+		}
+		buffer_free(&file_buffer);
+	}
+	uint64_t const cooked_elapsed = platform_timer_get_ticks() - cooked_ticks;
+
+	LOG("sources: %u\n", sources->count);
+	LOG("decoded: %.3f ms, %llu bytes\n", platform_timer_get_millis(source_elapsed), (unsigned long long)source_size);
+	LOG("cooked:  %.3f ms, %llu bytes\n", platform_timer_get_millis(cooked_elapsed), (unsigned long long)cooked_size);
+	if (stale_count > 0) { WRN("%u blobs are missing or of another version", stale_count); }
+}
+
+int main (int argc, char * argv[]) {
+	int arg_i = 1;
+	bool const bench = arguments_take_flag(argc, argv, &arg_i, S_("-bench"));
+
+	if (argc - arg_i < 1) {
+		LOG("usage: cooker [-bench] <directory>...\n");
+		return 1;
+	}
+
+	system_memory_pool_init();
+	system_memory_arena_init();
+	system_memory_debug_init();
+
+	struct Array sources = array_init(sizeof(struct Cooker_Source));
+	for (int i = arg_i; i < argc; i++) {
+		platform_file_iterate(arguments_get(argv[i]), cooker_collect, &sources);
+	}
+
+	int result = 0;
+	if (bench) { cooker_bench(&sources); }
+	else {
+		uint32_t cooked_count = 0, fresh_count = 0;
+		FOR_ARRAY(&sources, it) {
+			struct Cooker_Source const * source = it.value;
+			bool fresh = false;
+			if (!cooker_cook(source, &fresh)) {
+				ERR("can't cook \"%.*s\"", source->path.length, source->path.data);
+				result = 1;
+			}
+			else if (fresh) { fresh_count++; }
+			else            { cooked_count++; }
+		}
+		LOG("cooked %u sources, %u were fresh\n", cooked_count, fresh_count);
+	}
+
+	FOR_ARRAY(&sources, it) {
+		struct Cooker_Source const * source = it.value;
+		FREE((char *)(size_t)source->path.data);
+	}
+	array_free(&sources);
+
+	system_memory_debug_free();
+	system_memory_arena_free();
+	system_memory_pool_free();
+	return result;
+}
@@ -0,0 +1,99 @@
+#include "framework/formatter.h"
+#include "framework/maths.h"
+
+#include "framework/platform/file.h"
+#include "framework/platform/timer.h"
+#include "framework/containers/array.h"
+#include "framework/containers/buffer.h"
+
+#include "framework/systems/memory.h"
+#include "framework/systems/packs.h"
+
+#include "tools/arguments.h"
+
+// @note: usage
+//        `packer <pack> <directory>...`        packs every file found
+//        `packer -bench <pack> <directory>...` times reading the files loose
+//                                              against looking them up in the pack;
+//                                              flush the file cache for cold numbers
+
+static FILE_VISITOR(packer_collect) {
+	struct Array * names = data;
+	char * name_data = ALLOCATE_ARRAY(char, path.length + 1);
+	common_memcpy(name_data, path.data, path.length);
+	name_data[path.length] = '\0';
+	array_push_many(names, 1, &(struct CString){
+		.length = path.length,
+		.data = name_data,
+	});
+}
+
+static void packer_bench(struct CString pack_path, struct Array const * names) {
+	uint64_t loose_size = 0, loose_hash = 0;
+	uint64_t const loose_ticks = platform_timer_get_ticks();
+	FOR_ARRAY(names, it) {
+		struct CString const * name = it.value;
+		struct Buffer file_buffer = platform_file_read_entire(*name);
+		loose_size += file_buffer.size;
+		loose_hash ^= hash_u64_fnv1(file_buffer.data, file_buffer.size);
+		buffer_free(&file_buffer);
+	}
+	uint64_t const loose_elapsed = platform_timer_get_ticks() - loose_ticks;
+
+	uint64_t packed_size = 0, packed_hash = 0;
+	uint64_t const packed_ticks = platform_timer_get_ticks();
+	if (!system_packs_mount(pack_path)) { WRN("can't mount the pack"); return; }
+	FOR_ARRAY(names, it) {
+		struct CString const * name = it.value;
+		struct CBuffer const view = system_packs_find(*name);
+		packed_size += view.size;
+		packed_hash ^= hash_u64_fnv1(view.data, view.size);
+	}
+	uint64_t const packed_elapsed = platform_timer_get_ticks() - packed_ticks;
+
+	LOG("files:  %u\n", names->count);
+	LOG("loose:  %.3f ms, %llu bytes\n", platform_timer_get_millis(loose_elapsed),  (unsigned long long)loose_size);
+	LOG("packed: %.3f ms, %llu bytes\n", platform_timer_get_millis(packed_elapsed), (unsigned long long)packed_size);
+	if (loose_hash != packed_hash) { WRN("contents differ, the pack is stale"); }
+}
+
+int main (int argc, char * argv[]) {
+	int arg_i = 1;
+	bool const bench = arguments_take_flag(argc, argv, &arg_i, S_("-bench"));
+
+	if (argc - arg_i < 2) {
+		LOG("usage: packer [-bench] <pack> <directory>...\n");
+		return 1;
+	}
+
+	system_memory_pool_init();
+	system_memory_arena_init();
+	system_memory_debug_init();
+	system_packs_init();
+
+	struct CString const pack_path = arguments_get(argv[arg_i]);
+
+	struct Array names = array_init(sizeof(struct CString));
+	for (int i = arg_i + 1; i < argc; i++) {
+		platform_file_iterate(arguments_get(argv[i]), packer_collect, &names);
+	}
+
+	int result = 0;
+	if (bench) { packer_bench(pack_path, &names); }
+	else if (system_packs_write(pack_path, &names)) {
+		LOG("packed %u files into \"%.*s\"\n", names.count, pack_path.length, pack_path.data);
+	}
+	else { ERR("can't write \"%.*s\"", pack_path.length, pack_path.data); result = 1; }
+
+	FOR_ARRAY(&names, it) {
+		struct CString const * name = it.value;
+		FREE((char *)(size_t)name->data);
+	}
+	array_free(&names);
+
+	system_packs_free();
+	system_memory_debug_free();
+	system_memory_arena_free();
+	system_memory_pool_free();
+	return result;
+}